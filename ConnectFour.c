@@ -1,6 +1,17 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <stdatomic.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 #define RED     "\x1b[31m"
 #define GREEN   "\x1b[32m"
@@ -20,15 +31,129 @@ int depth;
 #define X_PIECE RED BOLD "X" RESET
 #define O_PIECE YELLOW BOLD "O" RESET
 
+// Endgame tablebase, loaded at startup when present (see README)
+#define TABLEBASE_FILE "ConnectFour.tb"
+#define TB_MAGIC "C4TB"
+#define TB_VERSION 3 // Version 3: sorted blocks of delta-coded keys (version 2: canonical keys)
+#define TB_BLOCK_ENTRIES 64 // Positions per compressed block
+#define TB_LOSS 1 // Results are stored for the player to move
+#define TB_DRAW 2
+#define TB_WIN  3
+
+// Header of a tablebase file, followed by blockCount TablebaseBlocks and dataSize bytes of block data
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t rows;
+    uint32_t cols;
+    uint32_t maxEmpty;
+    uint32_t blockCount;
+    uint64_t count;
+    uint64_t dataSize;
+} TablebaseHeader;
+
+// Index entry of a block of up to TB_BLOCK_ENTRIES positions, sorted by key
+typedef struct {
+    uint64_t firstKey;
+    uint64_t offset; // Start of the block in the block data
+} TablebaseBlock;
+
+static const TablebaseBlock *tbBlocks = NULL; // Mapped block index of the loaded tablebase, NULL if none
+static const uint8_t *tbData = NULL;
+static uint32_t tbBlockCount = 0;
+static uint64_t tbDataSize = 0;
+static void *tbMapping = NULL;
+static size_t tbMappingSize = 0;
+static int tbMaxEmpty = -1;              // -1 when no tablebase is loaded
+
+// Optional neural network evaluator, loaded at startup when present (see README)
+#define NETWORK_FILE "ConnectFour.nnue"
+#define NNUE_MAGIC "C4NN"
+#define NNUE_VERSION 1
+#define NNUE_FEATURES (2 * ROWS * COLS) // One input per cell and piece
+#define NNUE_HIDDEN 32                  // Accumulator width, a multiple of 16 for the AVX2 kernels
+#define NNUE_SCORE_LIMIT 900            // Network scores stay below every win score (1000 - depth)
+
+// Header of a network file, followed by the weights (see loadNetwork)
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t rows;
+    uint32_t cols;
+    uint32_t hidden;
+    int32_t outputShift;
+} NetworkHeader;
+
+static int networkLoaded = 0;
+static _Alignas(32) int16_t networkFeatureWeights[NNUE_FEATURES][NNUE_HIDDEN];
+static _Alignas(32) int16_t networkFeatureBias[NNUE_HIDDEN];
+static _Alignas(32) int16_t networkOutputWeights[NNUE_HIDDEN]; // int8 in the file, widened for the kernels
+static int32_t networkOutputBias;
+static int32_t networkOutputShift;
+static _Alignas(32) int16_t networkAccumulator[NNUE_HIDDEN];  // Feature sums of the board being searched
+
+// Persistent search cache, shared through a memory-mapped file (see README)
+#define SEARCH_CACHE_FILE "ConnectFour.cache"
+#define SEARCH_CACHE_MAGIC "C4SC"
+#define SEARCH_CACHE_VERSION 2 // Version 2: 16-bit generations
+#define SEARCH_CACHE_EVAL_VERSION 2 // Bump whenever evaluateBoard or minimax start returning different scores
+#define SEARCH_CACHE_WAYS 4         // Entries per bucket
+#define SEARCH_CACHE_BUCKETS_LOG2 16 // 65536 buckets of 4 entries, 4 MB
+
+// Entry data: score (16 bits), depth (8), best move of the canonical position (8), generation (16), checksum (16).
+// Ages are taken modulo 65536 runs: an entry that survives that many opens only looks younger than it is.
+#define SC_PAYLOAD(score, depth, move, gen) ((uint64_t)(uint16_t)(score) | ((uint64_t)(depth) << 16) | \
+                                             ((uint64_t)(move) << 24) | ((uint64_t)(gen) << 32))
+#define SC_PAYLOAD_MASK 0xFFFFFFFFFFFFULL
+#define SC_SCORE(data) ((int)(int16_t)((data) & 0xFFFF))
+#define SC_DEPTH(data) ((int)(((data) >> 16) & 0xFF))
+#define SC_MOVE(data) ((int)(((data) >> 24) & 0xFF))
+#define SC_GENERATION_MASK 0xFFFF
+#define SC_GENERATION(data) ((int)(((data) >> 32) & SC_GENERATION_MASK))
+#define SC_CHECKSUM(data) ((data) >> 48)
+
+// Header of a search cache file, followed by the entries
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t rows;
+    uint32_t cols;
+    uint64_t evalVersion;
+    uint32_t bucketsLog2;
+    _Atomic uint32_t generation; // Incremented every time the cache is opened
+} SearchCacheHeader;
+
+// The key is stored XOR-ed with the data, so a torn write never matches the key
+typedef struct {
+    _Atomic uint64_t check;
+    _Atomic uint64_t data;
+} SearchCacheEntry;
+
+static SearchCacheHeader *searchCache = NULL; // Mapped cache file, NULL if none
+static SearchCacheEntry *searchCacheEntries = NULL;
+static size_t searchCacheSize = 0;
+static int searchCacheGeneration = 0;
+static uint64_t searchCacheEvalVersion = 0; // getEvalVersion() when the cache was opened, mixed into every checksum
+
 // Declare the function prototypes
 void initBoard(char board[ROWS][COLS]);
 void printBoard(char board[ROWS][COLS]);
-void testinitBoard();
-void testDropPiece();
-void testCheckWin();
-void testGetAlignmentLength();
-void testGetBestMove();
-void testGetAIChoice();
+
+#ifdef CONNECTFOUR_TEST
+// Test prototypes (only built into the test binary, see README)
+int testinitBoard();
+int testDropPiece();
+int testCheckWin();
+int testGetAlignmentLength();
+int testGetBestMove();
+int testGetAIChoice();
+int testPerft();
+int testRandomized(unsigned long long seed, long positions);
+int testTablebase(unsigned long long seed);
+int testSymmetry(unsigned long long seed);
+int testNetwork(unsigned long long seed);
+int testSearchCache(unsigned long long seed);
+#endif
 
 // Declare the function prototypes
 int dropPiece(char board[ROWS][COLS], int col, char piece);
@@ -39,20 +164,67 @@ int getAlignmentLength(char board[ROWS][COLS], int row, int col, char piece);
 int evaluateBoard(char board[ROWS][COLS]);
 int minimax(char board[ROWS][COLS], int depth, int alpha, int beta, int isMaximizing);
 
-
-
-int main() {
+// Perft (move generation throughput and correctness) prototypes
+int undoPiece(char board[ROWS][COLS], int col);
+int getValidMoves(char board[ROWS][COLS], int moves[COLS]);
+unsigned long long perft(char board[ROWS][COLS], int depth, char piece);
+unsigned long long perftDivide(char board[ROWS][COLS], int depth, char piece, int threads, unsigned long long counts[COLS]);
+int runPerft(int argc, char *argv[]);
+
+// Position key, symmetry and endgame tablebase prototypes
+uint64_t getPositionKey(char board[ROWS][COLS], char piece);
+uint64_t getMirroredKey(uint64_t key);
+uint64_t getCanonicalKey(char board[ROWS][COLS], char piece, int *mirrored);
+int isSymmetric(char board[ROWS][COLS]);
+int countEmptyCells(char board[ROWS][COLS]);
+int loadTablebase(const char *path);
+void closeTablebase();
+int probeTablebase(char board[ROWS][COLS], char piece, int *result, int *distance);
+int tablebaseScore(int result, int distance, int depth, char piece);
+int getTablebaseMove(char board[ROWS][COLS], char piece);
+int generateTablebase(const char *path, int maxEmpty, long games, int sizeLog2);
+int runTablebase(int argc, char *argv[]);
+
+// Neural network evaluator prototypes
+int loadNetwork(const char *path);
+void refreshNetwork(char board[ROWS][COLS]);
+void addNetworkPiece(int row, int col, char piece);
+void removeNetworkPiece(int row, int col, char piece);
+int evaluateNetwork();
+
+// Persistent search cache prototypes
+uint64_t getEvalVersion();
+int openSearchCache(const char *path, int bucketsLog2);
+void closeSearchCache();
+int probeSearchCache(char board[ROWS][COLS], char piece, int depth, int *score, int *bestMove);
+void storeSearchCache(char board[ROWS][COLS], char piece, int depth, int score, int bestMove);
+
+
+
+#ifndef CONNECTFOUR_TEST
+int main(int argc, char *argv[]) {
     char board[ROWS][COLS];
     srand(time(NULL));
 
-    testinitBoard();
-    testDropPiece();
-    testCheckWin();
-    testGetAlignmentLength();
-    testGetBestMove();
-    testGetAIChoice();
+    // Command line tools: ./ConnectFour perft <depth> [threads] [moves]
+    //                     ./ConnectFour tablebase <file> <maxEmpty> <games> [sizeLog2]
+    if (argc > 1 && strcmp(argv[1], "perft") == 0) {
+        return runPerft(argc, argv);
+    }
+    if (argc > 1 && strcmp(argv[1], "tablebase") == 0) {
+        return runTablebase(argc, argv);
+    }
+
+    if (loadTablebase(TABLEBASE_FILE)) {
+        printf(MAGENTA "Endgame tablebase loaded (positions with up to %d empty cells).\n\n" RESET, tbMaxEmpty);
+    }
+    if (loadNetwork(NETWORK_FILE)) {
+        printf(MAGENTA "Neural network evaluation enabled (%s).\n\n" RESET, NETWORK_FILE);
+    }
+    if (openSearchCache(SEARCH_CACHE_FILE, SEARCH_CACHE_BUCKETS_LOG2) == 1) {
+        printf(MAGENTA "Search cache loaded from %s.\n\n" RESET, SEARCH_CACHE_FILE);
+    }
 
-    printf("\n\n\n\n\n");
     int turn, col, validMove, gameMode;
     char player;
     char playAgain;
@@ -178,6 +350,7 @@ int main() {
     printf(MAGENTA "Thanks for playing!\n");
     return 0;
 }
+#endif
 
 /**
  * Initializes the game board by setting all positions to an empty space (' ').
@@ -331,11 +504,26 @@ int getAIChoice(char board[ROWS][COLS], int lastPlayerMove) {
     int bestMove = -1;
     int bestScore = -10000;
 
-    for (int col = 0; col < COLS; col++) {
+    // Play perfectly once the position is covered by the endgame tablebase
+    bestMove = getTablebaseMove(board, 'O');
+    if (bestMove != -1) return bestMove;
+
+    // Reuse an earlier search of this position, possibly from a previous run (if its move is still playable)
+    int cachedScore, cachedMove;
+    if (probeSearchCache(board, 'O', depth, &cachedScore, &cachedMove) && board[0][cachedMove] == ' ') return cachedMove;
+
+    // Mirror-duplicate moves of a symmetric position score the same, search the left half only
+    int lastCol = isSymmetric(board) ? (COLS - 1) / 2 : COLS - 1;
+
+    if (networkLoaded) refreshNetwork(board);
+
+    for (int col = 0; col <= lastCol; col++) {
         for (int row = ROWS - 1; row >= 0; row--) {
             if (board[row][col] == ' ') {
                 board[row][col] = 'O';  // Simulate AI move
+                if (networkLoaded) addNetworkPiece(row, col, 'O');
                 int score = minimax(board, depth, -10000, 10000, 0); // Adjust depth as needed
+                if (networkLoaded) removeNetworkPiece(row, col, 'O');
                 board[row][col] = ' ';  // Undo move
 
                 if (score > bestScore) {
@@ -347,6 +535,8 @@ int getAIChoice(char board[ROWS][COLS], int lastPlayerMove) {
         }
     }
 
+    if (bestMove != -1) storeSearchCache(board, 'O', depth, bestScore, bestMove);
+
     // If no strategic move is found, pick the first available column
     if (bestMove == -1) {
         for (int col = 0; col < COLS; col++) {
@@ -379,40 +569,58 @@ int getAIChoice(char board[ROWS][COLS], int lastPlayerMove) {
  * @param beta The best value that the minimizer currently can guarantee at that level or above.
  * @param isMaximizing A flag indicating whether the current move is maximizing (1) or minimizing (0).
  * @return The evaluation score of the board.
+ *
+ * When a neural network is loaded, leaves are scored with evaluateNetwork and the accumulator is updated
+ * on every move made and taken back; it must match the board on entry (see refreshNetwork).
  */
 int minimax(char board[ROWS][COLS], int depth, int alpha, int beta, int isMaximizing) {
     if (checkWin(board, 'O')) return 1000 - depth;
     if (checkWin(board, 'X')) return -1000 + depth;
-    if (depth == 0) return evaluateBoard(board); // Stop at max depth
+
+    // Exact result from the endgame tablebase, if the position is in it
+    int tbResult, tbDistance;
+    char toMove = isMaximizing ? 'O' : 'X';
+    if (probeTablebase(board, toMove, &tbResult, &tbDistance)) return tablebaseScore(tbResult, tbDistance, depth, toMove);
+
+    if (depth == 0) return networkLoaded ? evaluateNetwork() : evaluateBoard(board); // Stop at max depth
+
+    // In a symmetric position the columns right of the center mirror the ones on the left
+    int lastCol = isSymmetric(board) ? (COLS - 1) / 2 : COLS - 1;
 
     if (isMaximizing) {
         int maxEval = -10000;
-        for (int col = 0; col < COLS; col++) {
+        for (int col = 0; col <= lastCol; col++) {
             for (int row = ROWS - 1; row >= 0; row--) {
                 if (board[row][col] == ' ') {
                     board[row][col] = 'O';
+                    if (networkLoaded) addNetworkPiece(row, col, 'O');
                     int eval = minimax(board, depth - 1, alpha, beta, 0);
+                    if (networkLoaded) removeNetworkPiece(row, col, 'O');
                     board[row][col] = ' ';
                     maxEval = (eval > maxEval) ? eval : maxEval;
                     alpha = (eval > alpha) ? eval : alpha;
-                    if (beta <= alpha) break;
+                    break; // Only the lowest empty cell is playable
                 }
             }
+            if (beta <= alpha) break;
         }
         return maxEval;
     } else {
         int minEval = 10000;
-        for (int col = 0; col < COLS; col++) {
+        for (int col = 0; col <= lastCol; col++) {
             for (int row = ROWS - 1; row >= 0; row--) {
                 if (board[row][col] == ' ') {
                     board[row][col] = 'X';
+                    if (networkLoaded) addNetworkPiece(row, col, 'X');
                     int eval = minimax(board, depth - 1, alpha, beta, 1);
+                    if (networkLoaded) removeNetworkPiece(row, col, 'X');
                     board[row][col] = ' ';
                     minEval = (eval < minEval) ? eval : minEval;
                     beta = (eval < beta) ? eval : beta;
-                    if (beta <= alpha) break;
+                    break; // Only the lowest empty cell is playable
                 }
             }
+            if (beta <= alpha) break;
         }
         return minEval;
     }
@@ -423,6 +631,8 @@ int minimax(char board[ROWS][COLS], int depth, int alpha, int beta, int isMaximi
  * This function assigns a score to the board based on the positions of the pieces.
  * It favors center column placements and evaluates all possible alignments (horizontal, vertical, diagonal).
  * The AI's pieces are given positive scores, while the player's pieces are given negative scores.
+ * Horizontal and diagonal windows are scored in both directions at half weight, so a board and its
+ * mirror image always get the same score (required by the symmetric pruning in minimax).
  *
  * @param board The game board represented as a 2D array of characters.
  * @return The evaluation score of the board.
@@ -444,8 +654,9 @@ int evaluateBoard(char board[ROWS][COLS]) {
             char piece = board[i][j];
             int pieceValue = (piece == 'O') ? 1 : -1; // AI is positive, Player is negative
 
-            // Evaluate all four possible directions
+            // Evaluate all seven possible directions (vertical is its own mirror image)
             int horizontal = 0, vertical = 0, diagonal1 = 0, diagonal2 = 0;
+            int horizontalBack = 0, diagonal1Back = 0, diagonal2Back = 0;
 
             // Horizontal (→)
             if (j + 3 < COLS) {
@@ -453,6 +664,12 @@ int evaluateBoard(char board[ROWS][COLS]) {
                     if (board[i][j + k] == piece) horizontal++;
             }
 
+            // Horizontal (←)
+            if (j - 3 >= 0) {
+                for (int k = 0; k < 4; k++) 
+                    if (board[i][j - k] == piece) horizontalBack++;
+            }
+
             // Vertical (↓)
             if (i + 3 < ROWS) {
                 for (int k = 0; k < 4; k++) 
@@ -465,19 +682,33 @@ int evaluateBoard(char board[ROWS][COLS]) {
                     if (board[i + k][j + k] == piece) diagonal1++;
             }
 
+            // Diagonal (\ upwards)
+            if (i - 3 >= 0 && j - 3 >= 0) {
+                for (int k = 0; k < 4; k++) 
+                    if (board[i - k][j - k] == piece) diagonal1Back++;
+            }
+
             // Diagonal (/)
             if (i - 3 >= 0 && j + 3 < COLS) {
                 for (int k = 0; k < 4; k++) 
                     if (board[i - k][j + k] == piece) diagonal2++;
             }
 
-            // Assign scores based on alignment length
-            int alignments[] = {horizontal, vertical, diagonal1, diagonal2};
-            for (int a = 0; a < 4; a++) {
+            // Diagonal (/ downwards)
+            if (i + 3 < ROWS && j - 3 >= 0) {
+                for (int k = 0; k < 4; k++) 
+                    if (board[i + k][j - k] == piece) diagonal2Back++;
+            }
+
+            // Assign scores based on alignment length, at half weight per direction
+            // (vertical is listed twice so it keeps its full weight)
+            int alignments[] = {horizontal, horizontalBack, vertical, vertical,
+                                diagonal1, diagonal1Back, diagonal2, diagonal2Back};
+            for (int a = 0; a < 8; a++) {
                 switch (alignments[a]) {
-                    case 4: score += 1000 * pieceValue; break; // Win condition
-                    case 3: score += 50 * pieceValue; break;   // Strong threat
-                    case 2: score += 10 * pieceValue; break;   // Weak threat
+                    case 4: score += 500 * pieceValue; break; // Win condition
+                    case 3: score += 25 * pieceValue; break;  // Strong threat
+                    case 2: score += 5 * pieceValue; break;   // Weak threat
                 }
             }
         }
@@ -588,212 +819,2372 @@ int getBestMove(char board[ROWS][COLS], char player) {
 }
 
 
+/**
+ * Removes the top piece from the specified column on the game board.
+ *
+ * This is the inverse of dropPiece: it clears the highest occupied cell of the column,
+ * so a search can make and unmake moves without copying the board.
+ *
+ * @param board The game board represented as a 2D array of characters.
+ * @param col The column whose top piece should be removed.
+ * @return 1 if a piece was removed, 0 if the column is invalid or empty.
+ */
+int undoPiece(char board[ROWS][COLS], int col) {
+    if (col < 0 || col >= COLS) {
+        return 0; // Invalid column
+    }
 
+    for (int i = 0; i < ROWS; i++) {
+        if (board[i][col] != ' ') {
+            board[i][col] = ' ';
+            return 1; // Success
+        }
+    }
 
-// TEST FUNCTIONS
-
-
+    return 0; // Column is empty
+}
 
 /**
- * Tests the initBoard function to ensure it correctly initializes the game board.
- * Creates a board and calls initBoard to set all positions to spaces (' ').
- * Verifies that every position in the board is a space by checking each cell.
- * Prints "initBoard PASSED" if all cells are spaces, "initBoard FAILED" otherwise.
+ * Generates the list of legal moves for the current board.
+ *
+ * A column is playable as long as its top cell is still empty.
+ * Columns are listed from left to right.
+ *
+ * @param board The game board represented as a 2D array of characters.
+ * @param moves Output array receiving the playable column indices.
+ * @return The number of playable columns written to moves.
  */
-void testinitBoard() {
-    char board[ROWS][COLS];
-    initBoard(board);
+int getValidMoves(char board[ROWS][COLS], int moves[COLS]) {
+    int count = 0;
 
-    int pass = 1;
-    for (int i = 0; i < ROWS; i++) {
-        for (int j = 0; j < COLS; j++) {
-            if (board[i][j] != ' ') {
-                pass = 0;
-            }
+    for (int col = 0; col < COLS; col++) {
+        if (board[0][col] == ' ') {
+            moves[count++] = col;
         }
     }
 
-    printf(pass ? "initBoard PASSED\n" : "initBoard FAILED\n");
+    return count;
 }
 
 /**
- * Tests the functionality of the dropPiece function through multiple scenarios.
- * This function performs four tests:
- * 1. Drops a single 'X' in column 3 and verifies it lands at the bottom.
- * 2. Stacks 'O' and 'X' in column 3, checking correct stacking order.
- * 3. Attempts to drop pieces in invalid columns (-1 and 10), expecting failure.
- * 4. Fills column 2 with 'O' pieces and tests that an additional 'X' is rejected.
- * Prints detailed test results for each step and a final "PASSED" or "FAILED" message.
- * If any test fails, the function exits early with a failure message.
+ * Counts the leaf nodes of the game tree to the given depth (perft).
+ *
+ * Every legal move is made with dropPiece, checked with checkWin and taken back with undoPiece.
+ * A move that wins the game ends that line: it is counted as a leaf only when it is played at the
+ * last ply, exactly like checkmates in chess perft. Draws (full boards) simply have no moves left.
+ *
+ * @param board The game board represented as a 2D array of characters.
+ * @param depth The number of plies still to play.
+ * @param piece The piece of the player to move ('X' or 'O').
+ * @return The number of leaf nodes reached at exactly the given depth.
  */
-void testDropPiece() {
+unsigned long long perft(char board[ROWS][COLS], int depth, char piece) {
+    if (depth == 0) return 1;
+
+    int moves[COLS];
+    int count = getValidMoves(board, moves);
+    char opponent = (piece == 'X') ? 'O' : 'X';
+    unsigned long long nodes = 0;
+
+    for (int m = 0; m < count; m++) {
+        dropPiece(board, moves[m], piece);
+        if (checkWin(board, piece)) {
+            nodes += (depth == 1) ? 1 : 0; // Game over, no further plies
+        } else {
+            nodes += perft(board, depth - 1, opponent);
+        }
+        undoPiece(board, moves[m]);
+    }
+
+    return nodes;
+}
+
+// Work item for one perft thread: a private copy of the root board and the root columns it owns
+typedef struct {
     char board[ROWS][COLS];
-    initBoard(board);
+    int depth;
+    char piece;
+    int firstCol;
+    int step;
+    unsigned long long *counts;
+} PerftTask;
 
-    // Test 1
-    int success = dropPiece(board, 3, 'X');
-    printf("Test 1: success=%d, board[5][3]=%c\n", success, board[5][3]);
-    if (!success || board[ROWS - 1][3] != 'X') {
-        printf("dropPiece FAILED (Expected 'X' in row %d, col 3)\n", ROWS - 1);
-        return;
+/**
+ * Thread entry point for perftDivide.
+ * Searches every root column firstCol, firstCol + step, ... on the task's own copy of the board.
+ */
+static void *perftWorker(void *arg) {
+    PerftTask *task = (PerftTask *)arg;
+    char opponent = (task->piece == 'X') ? 'O' : 'X';
+
+    for (int col = task->firstCol; col < COLS; col += task->step) {
+        if (!dropPiece(task->board, col, task->piece)) continue;
+        if (checkWin(task->board, task->piece)) {
+            task->counts[col] = (task->depth == 1) ? 1 : 0;
+        } else {
+            task->counts[col] = perft(task->board, task->depth - 1, opponent);
+        }
+        undoPiece(task->board, col);
     }
 
-    // Test 2
-    dropPiece(board, 3, 'O');
-    dropPiece(board, 3, 'X');
-    printf("Test 2: board[4][3]=%c, board[3][3]=%c\n", board[4][3], board[3][3]);
-    if (board[ROWS - 2][3] != 'O' || board[ROWS - 3][3] != 'X') {
-        printf("dropPiece FAILED (Stacking pieces incorrectly)\n");
-        return;
-    }
+    return NULL;
+}
 
-    // Test 3
-    int fail = dropPiece(board, -1, 'X') || dropPiece(board, 10, 'X');
-    printf("Test 3: fail=%d\n", fail);
-    if (fail) {
-        printf("dropPiece FAILED (Did not handle invalid columns correctly)\n");
-        return;
+/**
+ * Runs perft and splits the leaf count per root column.
+ *
+ * The root moves are distributed over the requested number of threads, each working on its own
+ * copy of the board. With a single thread everything runs on the caller's thread.
+ *
+ * @param board The game board represented as a 2D array of characters.
+ * @param depth The number of plies to play (must be at least 1).
+ * @param piece The piece of the player to move ('X' or 'O').
+ * @param threads The number of threads to use (clamped to 1 - COLS).
+ * @param counts Output array receiving the leaf count for each root column (0 for full columns).
+ * @return The total number of leaf nodes.
+ */
+unsigned long long perftDivide(char board[ROWS][COLS], int depth, char piece, int threads, unsigned long long counts[COLS]) {
+    PerftTask tasks[COLS];
+    pthread_t ids[COLS];
+    int started[COLS];
+    unsigned long long total = 0;
+
+    if (threads < 1) threads = 1;
+    if (threads > COLS) threads = COLS;
+
+    for (int col = 0; col < COLS; col++)
+        counts[col] = 0;
+
+    for (int t = 0; t < threads; t++) {
+        memcpy(tasks[t].board, board, sizeof(tasks[t].board));
+        tasks[t].depth = depth;
+        tasks[t].piece = piece;
+        tasks[t].firstCol = t;
+        tasks[t].step = threads;
+        tasks[t].counts = counts;
     }
 
-    // Test 4
-    for (int i = 0; i < ROWS; i++) {
-        dropPiece(board, 2, 'O');
-        printf("Filling column 2, row %d: %c\n", 5 - i, board[5 - i][2]);
-    }
-    int full = dropPiece(board, 2, 'X');
-    printf("Test 4: full=%d\n", full);
-    if (full) {
-        printf("dropPiece FAILED (Allowed piece to be placed in a full column)\n");
-        return;
+    if (threads == 1) {
+        perftWorker(&tasks[0]);
+    } else {
+        for (int t = 0; t < threads; t++) {
+            started[t] = pthread_create(&ids[t], NULL, perftWorker, &tasks[t]) == 0;
+            if (!started[t]) {
+                perftWorker(&tasks[t]); // Could not spawn, do the work here
+            }
+        }
+        for (int t = 0; t < threads; t++) {
+            if (started[t]) pthread_join(ids[t], NULL);
+        }
     }
 
-    printf("dropPiece PASSED\n");
+    for (int col = 0; col < COLS; col++)
+        total += counts[col];
+
+    return total;
 }
 
 /**
- * Tests the checkWin function for detecting winning conditions in Connect Four.
- * This function performs three tests:
- * 1. Places four 'X' pieces horizontally in columns 0-3 and checks for a win.
- * 2. Places four 'X' pieces vertically in column 3 and checks for a win.
- * 3. Places four 'X' pieces diagonally (bottom-left to top-right) and checks for a win.
- * Prints "PASSED" or "FAILED" for each test case (Horizontal, Vertical, Diagonal).
- * Resets the board between tests to ensure independence.
+ * Command line entry point: ./ConnectFour perft <depth> [threads] [moves]
+ *
+ * Sets up the position given by the optional move list (1-based columns, 'X' moves first),
+ * prints the leaf count for every root column, the total and the nodes per second.
+ *
+ * @param argc The argument count passed to main.
+ * @param argv The arguments passed to main.
+ * @return 0 on success, 1 on invalid arguments.
  */
-void testCheckWin() {
+int runPerft(int argc, char *argv[]) {
     char board[ROWS][COLS];
-    initBoard(board);
+    unsigned long long counts[COLS];
+    char piece = 'X';
 
-    // Horizontal Win
-    dropPiece(board, 0, 'X');
-    dropPiece(board, 1, 'X');
-    dropPiece(board, 2, 'X');
-    dropPiece(board, 3, 'X');
+    if (argc < 3) {
+        printf("Usage: %s perft <depth> [threads] [moves]\n", argv[0]);
+        return 1;
+    }
 
-    if (checkWin(board, 'X')) {
-        printf("checkWin (Horizontal) PASSED\n");
-    } else {
-        printf("checkWin (Horizontal) FAILED\n");
+    int perftDepth = atoi(argv[2]);
+    int threads = (argc > 3) ? atoi(argv[3]) : 1;
+    if (perftDepth < 1) {
+        printf(RED BOLD "Invalid depth. It must be at least 1.\n" RESET);
+        return 1;
     }
 
     initBoard(board);
+    if (argc > 4) {
+        for (const char *m = argv[4]; *m; m++) {
+            int col = *m - '1';
+            if (!dropPiece(board, col, piece) || checkWin(board, piece)) {
+                printf(RED BOLD "Invalid move list at '%c'.\n" RESET, *m);
+                return 1;
+            }
+            piece = (piece == 'X') ? 'O' : 'X';
+        }
+    }
 
-    // Vertical Win
-    dropPiece(board, 3, 'X');
-    dropPiece(board, 3, 'X');
-    dropPiece(board, 3, 'X');
-    dropPiece(board, 3, 'X');
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    unsigned long long total = perftDivide(board, perftDepth, piece, threads, counts);
+    clock_gettime(CLOCK_MONOTONIC, &end);
 
-    if (checkWin(board, 'X')) {
-        printf("checkWin (Vertical) PASSED\n");
-    } else {
-        printf("checkWin (Vertical) FAILED\n");
+    double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+    for (int col = 0; col < COLS; col++) {
+        printf("%d: %llu\n", col + 1, counts[col]);
     }
+    printf("\n" BOLD "Nodes: %llu\n" RESET, total);
+    printf("Time: %.3f s\n", seconds);
+    printf("Nodes/sec: %.0f\n", seconds > 0 ? total / seconds : 0.0);
 
-    initBoard(board);
+    return 0;
+}
 
-    // Diagonal Win
-    board[5][0] = 'X';
-    board[4][1] = 'X';
-    board[3][2] = 'X';
-    board[2][3] = 'X';
+/**
+ * Computes a unique 64-bit key for a position, seen from the player to move.
+ *
+ * Each column uses ROWS + 1 bits, bottom cell first. The key is the bitboard of the given piece
+ * plus the bitboard of all occupied cells, which is unique because the carry of every column
+ * lands on the first free bit above it. Boards with colours swapped map to the same key,
+ * which is what we want since game results are stored relative to the player to move.
+ *
+ * @param board The game board represented as a 2D array of characters.
+ * @param piece The piece of the player to move ('X' or 'O').
+ * @return The position key (never 0 for a non-empty board).
+ */
+uint64_t getPositionKey(char board[ROWS][COLS], char piece) {
+    uint64_t position = 0, mask = 0;
 
-    if (checkWin(board, 'X')) {
-        printf("checkWin (Diagonal) PASSED\n");
-    } else {
-        printf("checkWin (Diagonal) FAILED\n");
+    for (int col = 0; col < COLS; col++) {
+        for (int row = ROWS - 1; row >= 0; row--) {
+            if (board[row][col] == ' ') break;
+            uint64_t bit = (uint64_t)1 << (col * (ROWS + 1) + (ROWS - 1 - row));
+            mask |= bit;
+            if (board[row][col] == piece) position |= bit;
+        }
     }
+
+    return position + mask;
 }
 
 /**
- * Tests the getAlignmentLength function for calculating the longest sequence of pieces.
- * Sets up a board with three 'X' pieces horizontally at the bottom (columns 0-2).
- * Checks if the alignment length from the middle position (row 5, column 1) is 3.
- * Prints "PASSED" if the length is 3, "FAILED" otherwise.
+ * Mirrors a position key left to right by reversing the order of its columns.
+ *
+ * @param key A key returned by getPositionKey.
+ * @return The key of the mirrored position, with the same player to move.
  */
-void testGetAlignmentLength() {
-    char board[ROWS][COLS];
-    initBoard(board);
+uint64_t getMirroredKey(uint64_t key) {
+    uint64_t columnMask = ((uint64_t)1 << (ROWS + 1)) - 1;
+    uint64_t mirrored = 0;
 
-    board[5][0] = 'X';
-    board[5][1] = 'X';
-    board[5][2] = 'X';
-    
-    int length = getAlignmentLength(board, 5, 1, 'X');
-    
-    if (length == 3) {
-        printf("getAlignmentLength PASSED\n");
-    } else {
-        printf("getAlignmentLength FAILED\n");
+    for (int col = 0; col < COLS; col++) {
+        uint64_t column = (key >> (col * (ROWS + 1))) & columnMask;
+        mirrored |= column << ((COLS - 1 - col) * (ROWS + 1));
     }
+
+    return mirrored;
 }
 
 /**
- * Tests the getBestMove function for identifying a winning move.
- * Sets up a board with three 'X' pieces in columns 0-2.
- * Checks if the best move for 'X' is column 3, which would complete a horizontal win.
- * Prints "PASSED" if the best move is 3, "FAILED" with the returned value otherwise.
+ * Computes the key shared by a position and its mirror image.
+ *
+ * Connect Four is left-right symmetric, so a position and its mirror have the same value.
+ * Caches store the smaller of the two keys. Moves stored for the canonical position must be
+ * mapped back with col = COLS - 1 - col when *mirrored is set.
+ *
+ * @param board The game board represented as a 2D array of characters.
+ * @param piece The piece of the player to move ('X' or 'O').
+ * @param mirrored Receives 1 if the canonical key is the one of the mirrored board, 0 otherwise (may be NULL).
+ * @return The canonical position key.
  */
-void testGetBestMove() {
-    char board[ROWS][COLS];
-    initBoard(board);
+uint64_t getCanonicalKey(char board[ROWS][COLS], char piece, int *mirrored) {
+    uint64_t key = getPositionKey(board, piece);
+    uint64_t mirror = getMirroredKey(key);
+    int useMirror = mirror < key;
 
-    dropPiece(board, 0, 'X');
-    dropPiece(board, 1, 'X');
-    dropPiece(board, 2, 'X');
+    if (mirrored) *mirrored = useMirror;
+    return useMirror ? mirror : key;
+}
 
-    int bestMove = getBestMove(board, 'X');
+/**
+ * Checks if the board is its own mirror image.
+ *
+ * In a symmetric position playing column c or COLS - 1 - c leads to mirrored positions of equal value,
+ * so searches only need the columns up to the center.
+ *
+ * @param board The game board represented as a 2D array of characters.
+ * @return 1 if the board is left-right symmetric, 0 otherwise.
+ */
+int isSymmetric(char board[ROWS][COLS]) {
+    for (int row = ROWS - 1; row >= 0; row--) {
+        for (int col = 0; col < COLS / 2; col++) {
+            if (board[row][col] != board[row][COLS - 1 - col]) return 0;
+        }
+    }
+    return 1;
+}
 
-    if (bestMove == 3) {
-        printf("getBestMove PASSED\n");
-    } else {
-        printf("getBestMove FAILED (Expected 3, got %d)\n", bestMove);
+/**
+ * Counts the empty cells of the game board.
+ *
+ * @param board The game board represented as a 2D array of characters.
+ * @return The number of empty cells.
+ */
+int countEmptyCells(char board[ROWS][COLS]) {
+    int empty = 0;
+
+    for (int col = 0; col < COLS; col++) {
+        for (int row = 0; row < ROWS && board[row][col] == ' '; row++)
+            empty++;
     }
+
+    return empty;
 }
 
+// Generation table entries are (key << 8) | (distance << 2) | result, 0 marks an empty slot.
+// The file keeps the low byte (distance << 2) | result of each entry, which is never 0.
+#define TB_ENTRY(key, result, distance) (((uint64_t)(key) << 8) | ((uint64_t)(distance) << 2) | (uint64_t)(result))
+#define TB_KEY(entry) ((entry) >> 8)
+#define TB_RESULT(entry) ((int)((entry) & 3))
+#define TB_DISTANCE(entry) ((int)(((entry) >> 2) & 63))
+#define TB_INDEX(key, sizeLog2) (((key) * 0x9E3779B97F4A7C15ULL) >> (64 - (sizeLog2)))
+
 /**
- * Tests the getAIChoice function for selecting a winning move for the AI.
- * Sets up a board with three 'O' pieces in columns 0-2.
- * Checks if the AI chooses column 3 to complete a horizontal win for 'O'.
- * Prints "PASSED" if the AI move is 3, "FAILED" with the returned value otherwise.
- * Uses -1 as the last player move to indicate no prior move influence.
+ * Looks up a position in the open-addressed generation table (linear probing).
+ * Returns the entry, or 0 if the key is not stored.
  */
+static uint64_t findTablebaseEntry(const uint64_t *entries, uint32_t sizeLog2, uint64_t key) {
+    uint64_t mask = ((uint64_t)1 << sizeLog2) - 1;
+    uint64_t i = TB_INDEX(key, sizeLog2);
+
+    // Visit each slot at most once, even in a corrupt table without any empty slot
+    for (uint64_t probes = 0; probes <= mask; probes++, i = (i + 1) & mask) {
+        uint64_t entry = entries[i];
+        if (entry == 0) return 0;
+        if (TB_KEY(entry) == key) return entry;
+    }
+    return 0;
+}
+
 /**
- * Tests the getAIChoice function for various scenarios.
- * Verifies that the AI makes the correct move to win, block, or play strategically.
+ * Inserts an entry into the open-addressed generation table (linear probing).
+ * The caller must make sure the table still has an empty slot.
  */
-void testGetAIChoice() {
-    char board[ROWS][COLS];
-    initBoard(board);
+static void insertTablebaseEntry(uint64_t *entries, uint32_t sizeLog2, uint64_t entry) {
+    uint64_t mask = ((uint64_t)1 << sizeLog2) - 1;
+    uint64_t i = TB_INDEX(TB_KEY(entry), sizeLog2);
 
-    dropPiece(board, 0, 'O');
-    dropPiece(board, 1, 'O');
-    dropPiece(board, 2, 'O');
+    while (entries[i] != 0) i = (i + 1) & mask;
+    entries[i] = entry;
+}
 
-    int aiMove = getAIChoice(board, -1);
+/**
+ * Looks up a position in the loaded tablebase.
+ *
+ * Binary-searches the block index for the last block starting at or below the key, then decodes that
+ * block: the first key comes from the index, every further key is the previous one plus a LEB128 delta,
+ * and each key is followed by its (distance << 2) | result byte.
+ * Returns that byte, or 0 if the key is not stored.
+ */
+static int findTablebaseValue(uint64_t key) {
+    uint32_t low = 0, high = tbBlockCount;
 
-    if (aiMove == 3) {
-        printf("getAIChoice PASSED\n");
-    } else {
-        printf("getAIChoice FAILED (Expected 3, got %d)\n", aiMove);
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if (tbBlocks[mid].firstKey <= key) low = mid + 1;
+        else high = mid;
     }
+    if (low == 0) return 0;
+
+    uint64_t current = tbBlocks[low - 1].firstKey;
+    uint64_t i = tbBlocks[low - 1].offset;
+    uint64_t end = (low < tbBlockCount) ? tbBlocks[low].offset : tbDataSize;
+
+    while (i < end) {
+        int value = tbData[i++];
+        if (current == key) return value;
+
+        // Every byte of the delta is checked against the end of the block, even in a corrupt file
+        uint64_t delta = 0;
+        int shift = 0, more = 1;
+        while (more) {
+            if (i >= end || shift > 56) return 0;
+            delta |= (uint64_t)(tbData[i] & 0x7F) << shift;
+            more = tbData[i++] & 0x80;
+            shift += 7;
+        }
+        current += delta;
+        if (current > key) return 0;
+    }
+    return 0;
+}
+
+/**
+ * Maps a tablebase file into memory so minimax and getAIChoice can probe it.
+ *
+ * The file is validated against the board size and format version, its size against the header,
+ * and the block index must be sorted and point inside the block data. Any previously loaded
+ * tablebase is released first.
+ *
+ * @param path The path of the tablebase file.
+ * @return 1 if the tablebase was loaded, 0 if the file is missing or invalid.
+ */
+int loadTablebase(const char *path) {
+    TablebaseHeader header;
+    struct stat st;
+
+    closeTablebase();
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return 0;
+
+    if (fstat(fd, &st) != 0 || read(fd, &header, sizeof(header)) != (ssize_t)sizeof(header) ||
+        memcmp(header.magic, TB_MAGIC, 4) != 0 || header.version != TB_VERSION ||
+        header.rows != ROWS || header.cols != COLS ||
+        header.blockCount != (header.count + TB_BLOCK_ENTRIES - 1) / TB_BLOCK_ENTRIES ||
+        header.dataSize > (uint64_t)st.st_size ||
+        (uint64_t)st.st_size != sizeof(header) + (uint64_t)header.blockCount * sizeof(TablebaseBlock) + header.dataSize) {
+        close(fd);
+        return 0;
+    }
+
+    void *mapping = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) return 0;
+
+    const TablebaseBlock *blocks = (const TablebaseBlock *)((const char *)mapping + sizeof(header));
+    for (uint32_t b = 0; b < header.blockCount; b++) {
+        if (blocks[b].offset >= header.dataSize || (b == 0 ? blocks[b].offset != 0 :
+            blocks[b].offset <= blocks[b - 1].offset || blocks[b].firstKey <= blocks[b - 1].firstKey)) {
+            munmap(mapping, st.st_size);
+            return 0;
+        }
+    }
+
+    tbMapping = mapping;
+    tbMappingSize = st.st_size;
+    tbBlocks = blocks;
+    tbData = (const uint8_t *)(blocks + header.blockCount);
+    tbBlockCount = header.blockCount;
+    tbDataSize = header.dataSize;
+    tbMaxEmpty = (int)header.maxEmpty;
+    return 1;
+}
+
+/**
+ * Unmaps the currently loaded tablebase, if any.
+ */
+void closeTablebase() {
+    if (tbMapping) munmap(tbMapping, tbMappingSize);
+    tbMapping = NULL;
+    tbMappingSize = 0;
+    tbBlocks = NULL;
+    tbData = NULL;
+    tbBlockCount = 0;
+    tbDataSize = 0;
+    tbMaxEmpty = -1;
+}
+
+/**
+ * Probes the loaded tablebase for a position.
+ *
+ * Positions with more empty cells than the tablebase covers are rejected before the lookup,
+ * so the probe is cheap enough to run at every node of minimax.
+ *
+ * @param board The game board represented as a 2D array of characters.
+ * @param piece The piece of the player to move ('X' or 'O').
+ * @param result Receives TB_WIN, TB_DRAW or TB_LOSS for the player to move.
+ * @param distance Receives the number of plies until the game ends with perfect play.
+ * @return 1 if the position was found, 0 otherwise.
+ */
+int probeTablebase(char board[ROWS][COLS], char piece, int *result, int *distance) {
+    if (!tbBlocks || countEmptyCells(board) > tbMaxEmpty) return 0;
+
+    int value = findTablebaseValue(getCanonicalKey(board, piece, NULL));
+    if (!value) return 0;
+
+    *result = TB_RESULT(value);
+    *distance = TB_DISTANCE(value);
+    return 1;
+}
+
+/**
+ * Converts a tablebase result into a minimax score, from the AI's ('O') point of view.
+ * A win or loss gets the score minimax would give the final position once it is reached,
+ * draws score 0.
+ */
+int tablebaseScore(int result, int distance, int depth, char piece) {
+    if (result == TB_DRAW) return 0;
+
+    char winner = (result == TB_WIN) ? piece : (piece == 'X' ? 'O' : 'X');
+    return (winner == 'O') ? 1000 - (depth - distance) : -1000 + (depth - distance);
+}
+
+/**
+ * Picks the best move of a position covered by the tablebase.
+ *
+ * Every child is looked up: an immediate win is played at once, otherwise the move that leaves
+ * the opponent in the worst result is chosen, winning as fast and losing as slowly as possible.
+ *
+ * @param board The game board represented as a 2D array of characters.
+ * @param piece The piece of the player to move ('X' or 'O').
+ * @return The column index (0-based) to play, or -1 if the position or one of its children is not in the tablebase.
+ */
+int getTablebaseMove(char board[ROWS][COLS], char piece) {
+    int result, distance;
+    if (!probeTablebase(board, piece, &result, &distance)) return -1;
+
+    char opponent = (piece == 'X') ? 'O' : 'X';
+    int moves[COLS];
+    int count = getValidMoves(board, moves);
+    int bestMove = -1, bestResult = 0, bestDistance = 0;
+
+    for (int m = 0; m < count; m++) {
+        int childResult, childDistance, found;
+
+        dropPiece(board, moves[m], piece);
+        if (checkWin(board, piece)) {
+            undoPiece(board, moves[m]);
+            return moves[m];
+        }
+        found = probeTablebase(board, opponent, &childResult, &childDistance);
+        undoPiece(board, moves[m]);
+        if (!found) return -1;
+
+        // The opponent's loss is our win
+        int ours = (childResult == TB_WIN) ? TB_LOSS : (childResult == TB_LOSS) ? TB_WIN : TB_DRAW;
+        if (bestMove == -1 || ours > bestResult ||
+            (ours == bestResult && ours == TB_WIN && childDistance < bestDistance) ||
+            (ours == bestResult && ours == TB_LOSS && childDistance > bestDistance)) {
+            bestMove = moves[m];
+            bestResult = ours;
+            bestDistance = childDistance;
+        }
+    }
+
+    return bestMove;
+}
+
+// In-memory table used while generating a tablebase
+typedef struct {
+    uint64_t *entries;
+    uint32_t sizeLog2;
+    uint64_t count;
+    int full;
+} TablebaseBuilder;
+
+/**
+ * Solves a position exactly by exhaustive search, storing it and every position below it.
+ * The winner plays for the shortest win and the loser for the longest loss.
+ * Returns the result for the player to move and stores the distance to the end in *distance.
+ */
+static int solveTablebasePosition(TablebaseBuilder *builder, char board[ROWS][COLS], char piece, int *distance) {
+    uint64_t key = getCanonicalKey(board, piece, NULL);
+    uint64_t entry = findTablebaseEntry(builder->entries, builder->sizeLog2, key);
+    if (entry) {
+        *distance = TB_DISTANCE(entry);
+        return TB_RESULT(entry);
+    }
+
+    char opponent = (piece == 'X') ? 'O' : 'X';
+    int moves[COLS];
+    int count = getValidMoves(board, moves);
+    int bestResult = TB_DRAW, bestDistance = 0; // A full board is a draw
+
+    if (count > 0) bestResult = TB_LOSS, bestDistance = -1;
+
+    for (int m = 0; m < count && !builder->full; m++) {
+        int result, childDistance;
+
+        dropPiece(board, moves[m], piece);
+        if (checkWin(board, piece)) {
+            result = TB_WIN;
+            childDistance = 0;
+        } else {
+            int childResult = solveTablebasePosition(builder, board, opponent, &childDistance);
+            result = (childResult == TB_WIN) ? TB_LOSS : (childResult == TB_LOSS) ? TB_WIN : TB_DRAW;
+        }
+        undoPiece(board, moves[m]);
+        childDistance++;
+
+        if (result > bestResult ||
+            (result == bestResult && result == TB_WIN && childDistance < bestDistance) ||
+            (result == bestResult && result != TB_WIN && childDistance > bestDistance)) {
+            bestResult = result;
+            bestDistance = childDistance;
+        }
+    }
+
+    // Once the table is full generation is aborted, the returned result is never stored
+    *distance = 0;
+    if (builder->full) return TB_DRAW;
+
+    // Keep the load factor below 3/4 so probes stay short
+    if (builder->count + 1 > ((uint64_t)3 << builder->sizeLog2) / 4) {
+        builder->full = 1;
+        return TB_DRAW;
+    }
+
+    insertTablebaseEntry(builder->entries, builder->sizeLog2, TB_ENTRY(key, bestResult, bestDistance));
+    builder->count++;
+
+    *distance = bestDistance;
+    return bestResult;
+}
+
+/**
+ * Plays random moves (using rand()) from the empty board until at most maxEmpty cells are left.
+ * Returns 1 and the player to move in *piece if that endgame was reached, 0 if a player won first.
+ */
+static int playRandomEndgame(char board[ROWS][COLS], int maxEmpty, char *piece) {
+    int moves[COLS];
+
+    *piece = 'X';
+    initBoard(board);
+    while (countEmptyCells(board) > maxEmpty) {
+        int count = getValidMoves(board, moves);
+        dropPiece(board, moves[rand() % count], *piece);
+        if (checkWin(board, *piece)) return 0;
+        *piece = (*piece == 'X') ? 'O' : 'X';
+    }
+
+    return 1;
+}
+
+/**
+ * qsort comparator for generation table entries, ordering them by key.
+ */
+static int compareTablebaseEntries(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Generates an endgame tablebase file.
+ *
+ * Random games are played until maxEmpty cells are left. Every such position is then solved
+ * together with all positions reachable from it, so whenever a position is in the table,
+ * all of its children are as well. Results are collected in an open-addressed hash table of
+ * 2^sizeLog2 8-byte entries. For the file they are sorted by key and cut into blocks of
+ * TB_BLOCK_ENTRIES positions: each key is stored as a LEB128 delta from the previous one, followed by
+ * one (distance << 2) | result byte, and an index holds the first key and offset of every block.
+ *
+ * @param path The path of the tablebase file to write.
+ * @param maxEmpty The maximum number of empty cells of the stored positions.
+ * @param games The number of random games used to reach the endgame positions.
+ * @param sizeLog2 The log2 of the number of entries of the table used during generation.
+ * @return 1 on success, 0 if the table filled up or the file could not be written.
+ */
+int generateTablebase(const char *path, int maxEmpty, long games, int sizeLog2) {
+    TablebaseBuilder builder = { NULL, (uint32_t)sizeLog2, 0, 0 };
+    char board[ROWS][COLS];
+
+    builder.entries = calloc((size_t)1 << sizeLog2, sizeof(uint64_t));
+    if (!builder.entries) return 0;
+
+    for (long g = 0; g < games && !builder.full; g++) {
+        char piece;
+        int distance;
+
+        if (playRandomEndgame(board, maxEmpty, &piece)) {
+            solveTablebasePosition(&builder, board, piece, &distance);
+        }
+    }
+
+    if (builder.full) {
+        free(builder.entries);
+        return 0;
+    }
+
+    // Sort the entries by key (the key is in the high bits) and drop the empty slots
+    size_t tableSize = (size_t)1 << builder.sizeLog2, count = 0;
+    for (size_t i = 0; i < tableSize; i++) {
+        if (builder.entries[i]) builder.entries[count++] = builder.entries[i];
+    }
+    qsort(builder.entries, count, sizeof(uint64_t), compareTablebaseEntries);
+
+    // Delta-code the keys block by block; a LEB128 delta takes at most 10 bytes
+    uint32_t blockCount = (uint32_t)((count + TB_BLOCK_ENTRIES - 1) / TB_BLOCK_ENTRIES);
+    TablebaseBlock *blocks = calloc(blockCount ? blockCount : 1, sizeof(TablebaseBlock));
+    uint8_t *data = malloc(count * 11 + 1);
+    uint64_t dataSize = 0;
+    if (!blocks || !data) {
+        free(blocks);
+        free(data);
+        free(builder.entries);
+        return 0;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        uint64_t key = TB_KEY(builder.entries[i]);
+        if (i % TB_BLOCK_ENTRIES == 0) {
+            blocks[i / TB_BLOCK_ENTRIES].firstKey = key;
+            blocks[i / TB_BLOCK_ENTRIES].offset = dataSize;
+        } else {
+            uint64_t delta = key - TB_KEY(builder.entries[i - 1]);
+            do {
+                data[dataSize++] = (uint8_t)((delta & 0x7F) | (delta > 0x7F ? 0x80 : 0));
+                delta >>= 7;
+            } while (delta);
+        }
+        data[dataSize++] = (uint8_t)(builder.entries[i] & 0xFF);
+    }
+
+    TablebaseHeader header;
+    memcpy(header.magic, TB_MAGIC, 4);
+    header.version = TB_VERSION;
+    header.rows = ROWS;
+    header.cols = COLS;
+    header.maxEmpty = (uint32_t)maxEmpty;
+    header.blockCount = blockCount;
+    header.count = count;
+    header.dataSize = dataSize;
+
+    FILE *file = fopen(path, "wb");
+    int ok = file != NULL &&
+             fwrite(&header, sizeof(header), 1, file) == 1 &&
+             fwrite(blocks, sizeof(TablebaseBlock), blockCount, file) == blockCount &&
+             fwrite(data, 1, dataSize, file) == dataSize;
+    if (file && fclose(file) != 0) ok = 0;
+
+    free(blocks);
+    free(data);
+    free(builder.entries);
+    return ok;
+}
+
+/**
+ * Command line entry point: ./ConnectFour tablebase <file> <maxEmpty> <games> [sizeLog2]
+ *
+ * @param argc The argument count passed to main.
+ * @param argv The arguments passed to main.
+ * @return 0 on success, 1 on failure.
+ */
+int runTablebase(int argc, char *argv[]) {
+    if (argc < 5) {
+        printf("Usage: %s tablebase <file> <maxEmpty> <games> [sizeLog2]\n", argv[0]);
+        return 1;
+    }
+
+    int maxEmpty = atoi(argv[3]);
+    long games = atol(argv[4]);
+    int sizeLog2 = (argc > 5) ? atoi(argv[5]) : 24;
+    if (maxEmpty < 1 || maxEmpty > ROWS * COLS || games < 1 || sizeLog2 < 10 || sizeLog2 > 32) {
+        printf(RED BOLD "Invalid arguments. maxEmpty must be 1 - %d, games at least 1 and sizeLog2 10 - 32.\n" RESET, ROWS * COLS);
+        return 1;
+    }
+
+    if (!generateTablebase(argv[2], maxEmpty, games, sizeLog2)) {
+        printf(RED BOLD "Tablebase generation failed (table full or file not writable). Try a larger sizeLog2.\n" RESET);
+        return 1;
+    }
+
+    if (loadTablebase(argv[2])) {
+        uint64_t count = ((const TablebaseHeader *)tbMapping)->count;
+        printf("Tablebase written to %s: %llu positions with at most %d empty cells, %llu KB (%.1f bytes per position)\n",
+               argv[2], (unsigned long long)count, maxEmpty, (unsigned long long)(tbMappingSize >> 10),
+               (double)tbMappingSize / (double)count);
+        closeTablebase();
+    }
+    return 0;
+}
+
+/**
+ * Returns the input feature of a piece on a cell: one feature per cell for 'O' and one for 'X'.
+ */
+static int networkFeature(int row, int col, char piece) {
+    return (piece == 'O' ? 0 : ROWS * COLS) + row * COLS + col;
+}
+
+/**
+ * Adds (sign = 1) or subtracts (sign = -1) the weights of one feature to the accumulator.
+ */
+static void updateAccumulator(int feature, int sign) {
+    const int16_t *weights = networkFeatureWeights[feature];
+
+#ifdef __AVX2__
+    for (int i = 0; i < NNUE_HIDDEN; i += 16) {
+        __m256i acc = _mm256_load_si256((const __m256i *)&networkAccumulator[i]);
+        __m256i w = _mm256_load_si256((const __m256i *)&weights[i]);
+        acc = (sign > 0) ? _mm256_add_epi16(acc, w) : _mm256_sub_epi16(acc, w);
+        _mm256_store_si256((__m256i *)&networkAccumulator[i], acc);
+    }
+#else
+    for (int i = 0; i < NNUE_HIDDEN; i++)
+        networkAccumulator[i] = (int16_t)(networkAccumulator[i] + sign * weights[i]);
+#endif
+}
+
+/**
+ * Loads the weights of the neural network evaluator from a binary file.
+ *
+ * The file holds a NetworkHeader followed by the int16 accumulator biases, the int16 weights of
+ * every input feature, the int8 output weights and the int32 output bias. The network is rejected
+ * if its shape does not match, if the accumulator could overflow int16, if the output bias could
+ * overflow the int32 output sum, or if the feature weights are not left-right symmetric (minimax prunes mirrored moves, which needs a mirror-invariant evaluation).
+ *
+ * @param path The path of the network file.
+ * @return 1 if the network was loaded and is now used by minimax, 0 otherwise.
+ */
+int loadNetwork(const char *path) {
+    NetworkHeader header;
+    int8_t outputWeights[NNUE_HIDDEN];
+    int32_t outputBias;
+    int ok;
+
+    networkLoaded = 0;
+
+    FILE *file = fopen(path, "rb");
+    if (!file) return 0;
+
+    ok = fread(&header, sizeof(header), 1, file) == 1 &&
+         memcmp(header.magic, NNUE_MAGIC, 4) == 0 && header.version == NNUE_VERSION &&
+         header.rows == ROWS && header.cols == COLS && header.hidden == NNUE_HIDDEN &&
+         header.outputShift >= 0 && header.outputShift < 31 &&
+         fread(networkFeatureBias, sizeof(networkFeatureBias), 1, file) == 1 &&
+         fread(networkFeatureWeights, sizeof(networkFeatureWeights), 1, file) == 1 &&
+         fread(outputWeights, sizeof(outputWeights), 1, file) == 1 &&
+         fread(&outputBias, sizeof(outputBias), 1, file) == 1;
+    fclose(file);
+    if (!ok) return 0;
+
+    // The weighted sum stays below NNUE_HIDDEN * 127 * 127 in magnitude, far from half the int32 range
+    if (outputBias > INT32_MAX / 2 || outputBias < -(INT32_MAX / 2)) return 0;
+
+    for (int i = 0; i < NNUE_HIDDEN; i++) {
+        // Worst case: every cell holds the piece with the largest weight
+        int32_t worst = networkFeatureBias[i] < 0 ? -networkFeatureBias[i] : networkFeatureBias[i];
+        for (int row = 0; row < ROWS; row++) {
+            for (int col = 0; col < COLS; col++) {
+                int16_t o = networkFeatureWeights[networkFeature(row, col, 'O')][i];
+                int16_t x = networkFeatureWeights[networkFeature(row, col, 'X')][i];
+                if (o != networkFeatureWeights[networkFeature(row, COLS - 1 - col, 'O')][i] ||
+                    x != networkFeatureWeights[networkFeature(row, COLS - 1 - col, 'X')][i]) return 0;
+                int32_t largest = (o < 0 ? -o : o) > (x < 0 ? -x : x) ? (o < 0 ? -o : o) : (x < 0 ? -x : x);
+                worst += largest;
+            }
+        }
+        if (worst > INT16_MAX) return 0;
+
+        networkOutputWeights[i] = outputWeights[i];
+    }
+
+    networkOutputBias = outputBias;
+    networkOutputShift = header.outputShift;
+    networkLoaded = 1;
+    return 1;
+}
+
+/**
+ * Recomputes the accumulator of the neural network from scratch for the given board.
+ * Must be called before a search whenever the board changed outside of minimax and getAIChoice.
+ *
+ * @param board The game board represented as a 2D array of characters.
+ */
+void refreshNetwork(char board[ROWS][COLS]) {
+    memcpy(networkAccumulator, networkFeatureBias, sizeof(networkAccumulator));
+
+    for (int row = 0; row < ROWS; row++) {
+        for (int col = 0; col < COLS; col++) {
+            if (board[row][col] != ' ') updateAccumulator(networkFeature(row, col, board[row][col]), 1);
+        }
+    }
+}
+
+/**
+ * Incrementally updates the accumulator after a piece was dropped on a cell.
+ *
+ * @param row The row of the new piece.
+ * @param col The column of the new piece.
+ * @param piece The piece that was dropped ('X' or 'O').
+ */
+void addNetworkPiece(int row, int col, char piece) {
+    updateAccumulator(networkFeature(row, col, piece), 1);
+}
+
+/**
+ * Incrementally updates the accumulator after a piece was taken back from a cell.
+ *
+ * @param row The row of the removed piece.
+ * @param col The column of the removed piece.
+ * @param piece The piece that was removed ('X' or 'O').
+ */
+void removeNetworkPiece(int row, int col, char piece) {
+    updateAccumulator(networkFeature(row, col, piece), -1);
+}
+
+/**
+ * Evaluates the position held in the accumulator with the neural network.
+ *
+ * The accumulator goes through a clipped ReLU (0 - 127) and a dot product with the output weights,
+ * then the sum is scaled down by outputShift into the same units as evaluateBoard ('O' positive).
+ * The result is clamped to +-NNUE_SCORE_LIMIT, so a heuristic score is never mistaken for a forced win or loss.
+ *
+ * @return The evaluation score of the board.
+ */
+int evaluateNetwork() {
+    int32_t sum;
+
+#ifdef __AVX2__
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i clip = _mm256_set1_epi16(127);
+    __m256i total = _mm256_setzero_si256();
+
+    for (int i = 0; i < NNUE_HIDDEN; i += 16) {
+        __m256i acc = _mm256_load_si256((const __m256i *)&networkAccumulator[i]);
+        acc = _mm256_min_epi16(_mm256_max_epi16(acc, zero), clip);
+        __m256i w = _mm256_load_si256((const __m256i *)&networkOutputWeights[i]);
+        total = _mm256_add_epi32(total, _mm256_madd_epi16(acc, w));
+    }
+    __m128i half = _mm_add_epi32(_mm256_castsi256_si128(total), _mm256_extracti128_si256(total, 1));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+    sum = _mm_cvtsi128_si32(half);
+#else
+    sum = 0;
+    for (int i = 0; i < NNUE_HIDDEN; i++) {
+        int32_t activation = networkAccumulator[i] < 0 ? 0 : networkAccumulator[i] > 127 ? 127 : networkAccumulator[i];
+        sum += activation * networkOutputWeights[i];
+    }
+#endif
+
+    int score = (sum + networkOutputBias) >> networkOutputShift;
+    return score > NNUE_SCORE_LIMIT ? NNUE_SCORE_LIMIT : score < -NNUE_SCORE_LIMIT ? -NNUE_SCORE_LIMIT : score;
+}
+
+/**
+ * Computes the version of everything that determines search results, stored in the search cache header.
+ *
+ * Mixes SEARCH_CACHE_EVAL_VERSION with the weights of the loaded neural network and the shape of the
+ * loaded tablebase, so a cache written with a different evaluation is never reused.
+ *
+ * @return A 64-bit FNV-1a hash of the evaluation setup.
+ */
+uint64_t getEvalVersion() {
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    int32_t values[5] = { SEARCH_CACHE_EVAL_VERSION, networkLoaded, networkOutputBias, networkOutputShift, tbMaxEmpty };
+    const unsigned char *parts[5] = { (const unsigned char *)values, (const unsigned char *)networkFeatureBias,
+                                      (const unsigned char *)networkFeatureWeights, (const unsigned char *)networkOutputWeights,
+                                      (const unsigned char *)tbMapping };
+    size_t sizes[5] = { sizeof(values), sizeof(networkFeatureBias), sizeof(networkFeatureWeights),
+                        sizeof(networkOutputWeights), tbMapping ? sizeof(TablebaseHeader) : 0 };
+
+    if (!networkLoaded) { // Stale weights of a rejected or earlier file do not count
+        values[2] = values[3] = 0;
+        sizes[1] = sizes[2] = sizes[3] = 0;
+    }
+
+    for (int p = 0; p < 5; p++) {
+        for (size_t i = 0; i < sizes[p]; i++) {
+            hash ^= parts[p][i];
+            hash *= 0x100000001B3ULL;
+        }
+    }
+    return hash;
+}
+
+/**
+ * Checksum of a cache entry: 16 bits mixed from the key, the payload bits and the evaluation version,
+ * so an entry written under another evaluation does not validate even if the header was not updated.
+ */
+static uint64_t searchCacheChecksum(uint64_t key, uint64_t payload) {
+    return ((key ^ payload ^ searchCacheEvalVersion) * 0xD6E8FEB86659FD93ULL) >> 48;
+}
+
+/**
+ * Opens (or creates) the persistent search cache and maps it into memory.
+ *
+ * The file is shared with every other thread and process that maps it. If it does not exist, has the
+ * wrong size, or was written by another format or evaluation version (see getEvalVersion), a new empty
+ * cache is built under a temporary name and renamed over it. The old file is never truncated, because
+ * other processes may still have it mapped and would crash on the missing pages; they keep using the
+ * old copy until they reopen. Open the cache after the tablebase and network are loaded.
+ *
+ * @param path The path of the cache file.
+ * @param bucketsLog2 The log2 of the number of buckets (SEARCH_CACHE_WAYS entries each).
+ * @return 1 if an existing cache was reused, 2 if an empty cache was created, 0 on failure.
+ */
+int openSearchCache(const char *path, int bucketsLog2) {
+    size_t size = sizeof(SearchCacheHeader) + (sizeof(SearchCacheEntry) * SEARCH_CACHE_WAYS << bucketsLog2);
+    uint64_t evalVersion = getEvalVersion();
+    void *mapping = MAP_FAILED;
+    int fresh = 0;
+    struct stat st;
+
+    closeSearchCache();
+    if (bucketsLog2 < 1 || bucketsLog2 > 30) return 0;
+
+    // Reuse the existing file if it has the right size and a matching header
+    int fd = open(path, O_RDWR);
+    if (fd >= 0) {
+        if (fstat(fd, &st) == 0 && (size_t)st.st_size == size) {
+            mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        close(fd);
+    }
+    SearchCacheHeader *header = (SearchCacheHeader *)mapping;
+    if (mapping != MAP_FAILED &&
+        (memcmp(header->magic, SEARCH_CACHE_MAGIC, 4) != 0 || header->version != SEARCH_CACHE_VERSION ||
+         header->rows != ROWS || header->cols != COLS || header->evalVersion != evalVersion ||
+         header->bucketsLog2 != (uint32_t)bucketsLog2)) {
+        munmap(mapping, size); // Incompatible cache, start over
+        mapping = MAP_FAILED;
+    }
+
+    // Otherwise build an empty cache next to it and rename it into place once the header is written
+    if (mapping == MAP_FAILED) {
+        char tempPath[1024];
+        if (snprintf(tempPath, sizeof(tempPath), "%s.XXXXXX", path) >= (int)sizeof(tempPath)) return 0;
+
+        fd = mkstemp(tempPath);
+        if (fd < 0) return 0;
+        if (fchmod(fd, 0644) == 0 && ftruncate(fd, size) == 0) {
+            mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        close(fd);
+        if (mapping == MAP_FAILED) {
+            unlink(tempPath);
+            return 0;
+        }
+
+        header = (SearchCacheHeader *)mapping;
+        memcpy(header->magic, SEARCH_CACHE_MAGIC, 4);
+        header->version = SEARCH_CACHE_VERSION;
+        header->rows = ROWS;
+        header->cols = COLS;
+        header->evalVersion = evalVersion;
+        header->bucketsLog2 = (uint32_t)bucketsLog2;
+
+        if (rename(tempPath, path) != 0) {
+            munmap(mapping, size);
+            unlink(tempPath);
+            return 0;
+        }
+        fresh = 1;
+    }
+
+    searchCache = header;
+    searchCacheEntries = (SearchCacheEntry *)((char *)mapping + sizeof(SearchCacheHeader));
+    searchCacheSize = size;
+    searchCacheEvalVersion = evalVersion;
+    searchCacheGeneration = (atomic_fetch_add(&header->generation, 1) + 1) & SC_GENERATION_MASK;
+    return fresh ? 2 : 1;
+}
+
+/**
+ * Unmaps the search cache, if any. Entries already written stay in the file.
+ */
+void closeSearchCache() {
+    if (searchCache) munmap(searchCache, searchCacheSize);
+    searchCache = NULL;
+    searchCacheEntries = NULL;
+    searchCacheSize = 0;
+}
+
+/**
+ * Returns the first entry of the bucket of a position searched to a given depth.
+ */
+static SearchCacheEntry *searchCacheBucket(uint64_t key, int depth) {
+    uint64_t hash = (key ^ ((uint64_t)depth << 56)) * 0x9E3779B97F4A7C15ULL;
+    return &searchCacheEntries[(hash >> (64 - searchCache->bucketsLog2)) * SEARCH_CACHE_WAYS];
+}
+
+/**
+ * Looks up the result of an earlier search of a position to exactly the given depth.
+ *
+ * Entries are read without locks: the key is stored XOR-ed with the data, so an entry that is
+ * half-written by another thread or process fails the key check, and the checksum catches
+ * any other corruption. Positions are looked up by canonical key and the move is mirrored back.
+ *
+ * @param board The game board represented as a 2D array of characters.
+ * @param piece The piece of the player to move ('X' or 'O').
+ * @param depth The search depth of the wanted result.
+ * @param score Receives the stored score.
+ * @param bestMove Receives the stored best column (0-based) for this board, always less than COLS.
+ * @return 1 if a valid entry was found, 0 otherwise.
+ */
+int probeSearchCache(char board[ROWS][COLS], char piece, int depth, int *score, int *bestMove) {
+    if (!searchCache) return 0;
+
+    int mirrored;
+    uint64_t key = getCanonicalKey(board, piece, &mirrored);
+    SearchCacheEntry *bucket = searchCacheBucket(key, depth);
+
+    for (int w = 0; w < SEARCH_CACHE_WAYS; w++) {
+        uint64_t data = atomic_load_explicit(&bucket[w].data, memory_order_relaxed);
+        uint64_t check = atomic_load_explicit(&bucket[w].check, memory_order_relaxed);
+
+        if ((check ^ data) != key || SC_DEPTH(data) != depth || SC_MOVE(data) >= COLS) continue;
+        if (SC_CHECKSUM(data) != searchCacheChecksum(key, data & SC_PAYLOAD_MASK)) continue;
+
+        *score = SC_SCORE(data);
+        *bestMove = mirrored ? COLS - 1 - SC_MOVE(data) : SC_MOVE(data);
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Stores the result of a search in the cache.
+ *
+ * Within the bucket, an entry for the same position and depth is overwritten first, then an empty
+ * entry, then the entry from the oldest run (lowest depth on ties). Each 64-bit word is written
+ * atomically; readers detect an entry whose two words do not belong together.
+ *
+ * @param board The game board represented as a 2D array of characters.
+ * @param piece The piece of the player to move ('X' or 'O').
+ * @param depth The depth of the search.
+ * @param score The score found by the search.
+ * @param bestMove The best column (0-based) found by the search.
+ */
+void storeSearchCache(char board[ROWS][COLS], char piece, int depth, int score, int bestMove) {
+    if (!searchCache || depth < 0 || depth > 255 || bestMove < 0 || bestMove >= COLS) return;
+
+    int mirrored;
+    uint64_t key = getCanonicalKey(board, piece, &mirrored);
+    SearchCacheEntry *bucket = searchCacheBucket(key, depth);
+    SearchCacheEntry *victim = NULL;
+    int emptyAge = SC_GENERATION_MASK + 1; // Older than any used entry can be
+    int victimAge = -1, victimDepth = 0;
+
+    for (int w = 0; w < SEARCH_CACHE_WAYS; w++) {
+        uint64_t data = atomic_load_explicit(&bucket[w].data, memory_order_relaxed);
+        uint64_t check = atomic_load_explicit(&bucket[w].check, memory_order_relaxed);
+
+        if (data == 0 && check == 0) {
+            if (victimAge < emptyAge) victim = &bucket[w], victimAge = emptyAge; // Empty beats any used entry
+            continue;
+        }
+        if ((check ^ data) == key && SC_DEPTH(data) == depth) {
+            victim = &bucket[w];
+            break;
+        }
+
+        int age = (searchCacheGeneration - (int)SC_GENERATION(data)) & SC_GENERATION_MASK;
+        if (victimAge < emptyAge && (age > victimAge || (age == victimAge && (int)SC_DEPTH(data) < victimDepth))) {
+            victim = &bucket[w];
+            victimAge = age;
+            victimDepth = (int)SC_DEPTH(data);
+        }
+    }
+
+    if (score > INT16_MAX) score = INT16_MAX;
+    if (score < INT16_MIN) score = INT16_MIN;
+
+    uint64_t payload = SC_PAYLOAD(score, depth, mirrored ? COLS - 1 - bestMove : bestMove, searchCacheGeneration);
+    uint64_t data = payload | (searchCacheChecksum(key, payload) << 48);
+
+    atomic_store_explicit(&victim->data, data, memory_order_relaxed);
+    atomic_store_explicit(&victim->check, key ^ data, memory_order_relaxed);
+}
+
+
+
+// TEST FUNCTIONS
+
+#ifdef CONNECTFOUR_TEST
+
+
+
+/**
+ * Tests the initBoard function to ensure it correctly initializes the game board.
+ * Creates a board and calls initBoard to set all positions to spaces (' ').
+ * Verifies that every position in the board is a space by checking each cell.
+ * Prints "initBoard PASSED" if all cells are spaces, "initBoard FAILED" otherwise.
+ */
+int testinitBoard() {
+    char board[ROWS][COLS];
+    initBoard(board);
+
+    int pass = 1;
+    for (int i = 0; i < ROWS; i++) {
+        for (int j = 0; j < COLS; j++) {
+            if (board[i][j] != ' ') {
+                pass = 0;
+            }
+        }
+    }
+
+    printf(pass ? "initBoard PASSED\n" : "initBoard FAILED\n");
+    return pass;
+}
+
+/**
+ * Tests the functionality of the dropPiece function through multiple scenarios.
+ * This function performs four tests:
+ * 1. Drops a single 'X' in column 3 and verifies it lands at the bottom.
+ * 2. Stacks 'O' and 'X' in column 3, checking correct stacking order.
+ * 3. Attempts to drop pieces in invalid columns (-1 and 10), expecting failure.
+ * 4. Fills column 2 with 'O' pieces and tests that an additional 'X' is rejected.
+ * Prints detailed test results for each step and a final "PASSED" or "FAILED" message.
+ * If any test fails, the function exits early with a failure message.
+ */
+int testDropPiece() {
+    char board[ROWS][COLS];
+    initBoard(board);
+
+    // Test 1
+    int success = dropPiece(board, 3, 'X');
+    printf("Test 1: success=%d, board[5][3]=%c\n", success, board[5][3]);
+    if (!success || board[ROWS - 1][3] != 'X') {
+        printf("dropPiece FAILED (Expected 'X' in row %d, col 3)\n", ROWS - 1);
+        return 0;
+    }
+
+    // Test 2
+    dropPiece(board, 3, 'O');
+    dropPiece(board, 3, 'X');
+    printf("Test 2: board[4][3]=%c, board[3][3]=%c\n", board[4][3], board[3][3]);
+    if (board[ROWS - 2][3] != 'O' || board[ROWS - 3][3] != 'X') {
+        printf("dropPiece FAILED (Stacking pieces incorrectly)\n");
+        return 0;
+    }
+
+    // Test 3
+    int fail = dropPiece(board, -1, 'X') || dropPiece(board, 10, 'X');
+    printf("Test 3: fail=%d\n", fail);
+    if (fail) {
+        printf("dropPiece FAILED (Did not handle invalid columns correctly)\n");
+        return 0;
+    }
+
+    // Test 4
+    for (int i = 0; i < ROWS; i++) {
+        dropPiece(board, 2, 'O');
+        printf("Filling column 2, row %d: %c\n", 5 - i, board[5 - i][2]);
+    }
+    int full = dropPiece(board, 2, 'X');
+    printf("Test 4: full=%d\n", full);
+    if (full) {
+        printf("dropPiece FAILED (Allowed piece to be placed in a full column)\n");
+        return 0;
+    }
+
+    printf("dropPiece PASSED\n");
+    return 1;
+}
+
+/**
+ * Tests the checkWin function for detecting winning conditions in Connect Four.
+ * This function performs three tests:
+ * 1. Places four 'X' pieces horizontally in columns 0-3 and checks for a win.
+ * 2. Places four 'X' pieces vertically in column 3 and checks for a win.
+ * 3. Places four 'X' pieces diagonally (bottom-left to top-right) and checks for a win.
+ * Prints "PASSED" or "FAILED" for each test case (Horizontal, Vertical, Diagonal).
+ * Resets the board between tests to ensure independence.
+ */
+int testCheckWin() {
+    char board[ROWS][COLS];
+    int pass = 1;
+    initBoard(board);
+
+    // Horizontal Win
+    dropPiece(board, 0, 'X');
+    dropPiece(board, 1, 'X');
+    dropPiece(board, 2, 'X');
+    dropPiece(board, 3, 'X');
+
+    if (checkWin(board, 'X')) {
+        printf("checkWin (Horizontal) PASSED\n");
+    } else {
+        printf("checkWin (Horizontal) FAILED\n");
+        pass = 0;
+    }
+
+    initBoard(board);
+
+    // Vertical Win
+    dropPiece(board, 3, 'X');
+    dropPiece(board, 3, 'X');
+    dropPiece(board, 3, 'X');
+    dropPiece(board, 3, 'X');
+
+    if (checkWin(board, 'X')) {
+        printf("checkWin (Vertical) PASSED\n");
+    } else {
+        printf("checkWin (Vertical) FAILED\n");
+        pass = 0;
+    }
+
+    initBoard(board);
+
+    // Diagonal Win
+    board[5][0] = 'X';
+    board[4][1] = 'X';
+    board[3][2] = 'X';
+    board[2][3] = 'X';
+
+    if (checkWin(board, 'X')) {
+        printf("checkWin (Diagonal) PASSED\n");
+    } else {
+        printf("checkWin (Diagonal) FAILED\n");
+        pass = 0;
+    }
+
+    return pass;
+}
+
+/**
+ * Tests the getAlignmentLength function for calculating the longest sequence of pieces.
+ * Sets up a board with three 'X' pieces horizontally at the bottom (columns 0-2).
+ * Checks if the alignment length from the middle position (row 5, column 1) is 3.
+ * Prints "PASSED" if the length is 3, "FAILED" otherwise.
+ */
+int testGetAlignmentLength() {
+    char board[ROWS][COLS];
+    initBoard(board);
+
+    board[5][0] = 'X';
+    board[5][1] = 'X';
+    board[5][2] = 'X';
+    
+    int length = getAlignmentLength(board, 5, 1, 'X');
+    
+    if (length == 3) {
+        printf("getAlignmentLength PASSED\n");
+    } else {
+        printf("getAlignmentLength FAILED\n");
+    }
+
+    return length == 3;
+}
+
+/**
+ * Tests the getBestMove function for identifying a winning move.
+ * Sets up a board with three 'X' pieces in columns 0-2.
+ * Checks if the best move for 'X' is column 3, which would complete a horizontal win.
+ * Prints "PASSED" if the best move is 3, "FAILED" with the returned value otherwise.
+ */
+int testGetBestMove() {
+    char board[ROWS][COLS];
+    initBoard(board);
+
+    dropPiece(board, 0, 'X');
+    dropPiece(board, 1, 'X');
+    dropPiece(board, 2, 'X');
+
+    int bestMove = getBestMove(board, 'X');
+
+    if (bestMove == 3) {
+        printf("getBestMove PASSED\n");
+    } else {
+        printf("getBestMove FAILED (Expected 3, got %d)\n", bestMove);
+    }
+
+    return bestMove == 3;
+}
+
+/**
+ * Tests the getAIChoice function for selecting a winning move for the AI.
+ * Sets up a board with three 'O' pieces in columns 0-2.
+ * Checks if the AI chooses column 3 to complete a horizontal win for 'O'.
+ * Prints "PASSED" if the AI move is 3, "FAILED" with the returned value otherwise.
+ * Uses -1 as the last player move to indicate no prior move influence.
+ */
+/**
+ * Tests the getAIChoice function for various scenarios.
+ * Verifies that the AI makes the correct move to win, block, or play strategically.
+ */
+int testGetAIChoice() {
+    char board[ROWS][COLS];
+    initBoard(board);
+
+    dropPiece(board, 0, 'O');
+    dropPiece(board, 1, 'O');
+    dropPiece(board, 2, 'O');
+
+    int aiMove = getAIChoice(board, -1);
+
+    if (aiMove == 3) {
+        printf("getAIChoice PASSED\n");
+    } else {
+        printf("getAIChoice FAILED (Expected 3, got %d)\n", aiMove);
+    }
+
+    return aiMove == 3;
+}
+
+/**
+ * Tests the perft function against the reference leaf counts of the empty 7x6 board.
+ * Up to 6 plies every sequence of moves is legal, so the counts are powers of 7.
+ * At 7 plies the 7 lines that fill a single column lose one move each.
+ * Also checks that perftDivide splits the depth 7 count evenly over the root columns with several threads,
+ * and that the board is left untouched afterwards.
+ * Prints "perft PASSED" if every count matches, "perft FAILED" with the first mismatch otherwise.
+ */
+int testPerft() {
+    static const unsigned long long expected[] = { 1, 7, 49, 343, 2401, 16807, 117649, 823536 };
+    char board[ROWS][COLS];
+    unsigned long long counts[COLS];
+    initBoard(board);
+
+    for (int d = 1; d <= 7; d++) {
+        unsigned long long nodes = perft(board, d, 'X');
+        if (nodes != expected[d]) {
+            printf("perft FAILED (Depth %d: expected %llu, got %llu)\n", d, expected[d], nodes);
+            return 0;
+        }
+    }
+
+    unsigned long long total = perftDivide(board, 7, 'X', 3, counts);
+    for (int col = 0; col < COLS; col++) {
+        if (counts[col] != expected[7] / COLS) {
+            printf("perft FAILED (Divide column %d: expected %llu, got %llu)\n", col, expected[7] / COLS, counts[col]);
+            return 0;
+        }
+    }
+    if (total != expected[7]) {
+        printf("perft FAILED (Divide total: expected %llu, got %llu)\n", expected[7], total);
+        return 0;
+    }
+
+    for (int i = 0; i < ROWS; i++) {
+        for (int j = 0; j < COLS; j++) {
+            if (board[i][j] != ' ') {
+                printf("perft FAILED (Board modified at row %d, col %d)\n", i, j);
+                return 0;
+            }
+        }
+    }
+
+    printf("perft PASSED\n");
+    return 1;
+}
+
+// RANDOMIZED DIFFERENTIAL TESTS
+
+/*
+ * Every position is described by the list of columns played from the empty board, 'X' moving first.
+ * The optimised routines are compared against slow, straightforward reference implementations.
+ * Positions come from a seeded xorshift generator, so a run is reproduced by passing the same seed,
+ * and a failing move list is shrunk to a minimal one before it is reported.
+ */
+
+#define MAX_MOVES (ROWS * COLS)
+#define SEARCH_CHECK_DEPTH 3     // Depth of the minimax / reference search comparison
+#define SEARCH_CHECK_INTERVAL 64 // Compare searches on every Nth position only (they are the slow part)
+#define TEST_PATH_SIZE 32        // Room for the path of a temporary test file
+
+static unsigned long long rngState;
+
+/**
+ * Returns the next number of the xorshift64* generator used by the randomized tests.
+ * Independent of rand() so the sequence is identical on every platform.
+ */
+static unsigned long long nextRandom() {
+    rngState ^= rngState >> 12;
+    rngState ^= rngState << 25;
+    rngState ^= rngState >> 27;
+    return rngState * 2685821657736338717ULL;
+}
+
+/**
+ * Reference win check: tests each of the possible windows of four cells one by one.
+ */
+static int refCheckWin(char board[ROWS][COLS], char piece) {
+    static const int directions[4][2] = { {0, 1}, {1, 0}, {1, 1}, {-1, 1} };
+
+    for (int d = 0; d < 4; d++) {
+        for (int r = 0; r < ROWS; r++) {
+            for (int c = 0; c < COLS; c++) {
+                int count = 0;
+                for (int k = 0; k < 4; k++) {
+                    int rr = r + directions[d][0] * k, cc = c + directions[d][1] * k;
+                    if (rr < 0 || rr >= ROWS || cc < 0 || cc >= COLS || board[rr][cc] != piece) break;
+                    count++;
+                }
+                if (count == 4) return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * Replays a move list on an empty board.
+ * Returns 0 if the list is not a legal game: a move into a full column, or any move after a win.
+ */
+static int replayMoves(char board[ROWS][COLS], const int moves[], int count) {
+    char piece = 'X';
+    initBoard(board);
+
+    for (int i = 0; i < count; i++) {
+        if (!dropPiece(board, moves[i], piece)) return 0;
+        if (i < count - 1 && refCheckWin(board, piece)) return 0;
+        piece = (piece == 'X') ? 'O' : 'X';
+    }
+    return 1;
+}
+
+/**
+ * Creates an empty temporary file for a test and stores its path in path.
+ * Prints "<name> FAILED" and returns 0 if the file could not be created.
+ */
+static int createTestFile(char path[TEST_PATH_SIZE], const char *name) {
+    strcpy(path, "/tmp/ConnectFourTestXXXXXX");
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        printf("%s FAILED (Could not create a temporary file)\n", name);
+        return 0;
+    }
+    close(fd);
+    return 1;
+}
+
+/**
+ * Copies a board into mirror, flipped left to right.
+ */
+static void mirrorBoard(char board[ROWS][COLS], char mirror[ROWS][COLS]) {
+    for (int r = 0; r < ROWS; r++) {
+        for (int c = 0; c < COLS; c++) {
+            mirror[r][c] = board[r][COLS - 1 - c];
+        }
+    }
+}
+
+/**
+ * Drops a piece into a random playable column, chosen with the seeded generator.
+ * Returns the column played, or -1 if the board is full.
+ */
+static int playRandomMove(char board[ROWS][COLS], char piece) {
+    int moves[COLS];
+    int count = getValidMoves(board, moves);
+
+    if (count == 0) return -1;
+    int col = moves[nextRandom() % count];
+    dropPiece(board, col, piece);
+    return col;
+}
+
+/**
+ * Plays random legal moves from the empty board, 'X' first, until length moves were played,
+ * a player won or the board is full. The columns are recorded in moves (may be NULL).
+ * Returns the number of moves played and the player to move next in *toMove.
+ */
+static int playRandomGame(char board[ROWS][COLS], int moves[], int length, char *toMove) {
+    int count = 0;
+    char piece = 'X';
+
+    initBoard(board);
+    while (count < length) {
+        int col = playRandomMove(board, piece);
+        if (col < 0) break;
+        if (moves) moves[count] = col;
+        count++;
+        int won = checkWin(board, piece);
+        piece = (piece == 'X') ? 'O' : 'X';
+        if (won) break;
+    }
+
+    *toMove = piece;
+    return count;
+}
+
+/**
+ * Scores the windows anchored at each occupied cell going right, down, down-right and up-right,
+ * plus the center column bonus, written as a table-driven loop.
+ */
+static int refAnchoredScore(char board[ROWS][COLS]) {
+    static const int directions[4][2] = { {0, 1}, {1, 0}, {1, 1}, {-1, 1} };
+    static const int windowScore[5] = { 0, 0, 10, 50, 1000 };
+    int score = 0;
+
+    for (int r = 0; r < ROWS; r++) {
+        if (board[r][COLS / 2] == 'O') score += 5;
+        if (board[r][COLS / 2] == 'X') score -= 5;
+    }
+
+    for (int r = 0; r < ROWS; r++) {
+        for (int c = 0; c < COLS; c++) {
+            if (board[r][c] == ' ') continue;
+            int sign = (board[r][c] == 'O') ? 1 : -1;
+
+            for (int d = 0; d < 4; d++) {
+                int endR = r + directions[d][0] * 3, endC = c + directions[d][1] * 3;
+                if (endR < 0 || endR >= ROWS || endC < 0 || endC >= COLS) continue;
+
+                int count = 0;
+                for (int k = 0; k < 4; k++) {
+                    if (board[r + directions[d][0] * k][c + directions[d][1] * k] == board[r][c]) count++;
+                }
+                score += sign * windowScore[count];
+            }
+        }
+    }
+    return score;
+}
+
+/**
+ * Reference evaluation: the average of the anchored score of the board and of its mirror image,
+ * which covers the leftward directions that evaluateBoard scores at half weight.
+ */
+static int refEvaluateBoard(char board[ROWS][COLS]) {
+    char mirror[ROWS][COLS];
+
+    mirrorBoard(board, mirror);
+    return (refAnchoredScore(board) + refAnchoredScore(mirror)) / 2;
+}
+
+/**
+ * Reference search: plain minimax over the full tree without alpha-beta pruning.
+ * Uses the same terminal and depth scoring as minimax, so both must return the same value.
+ */
+static int refMinimax(char board[ROWS][COLS], int depth, int isMaximizing) {
+    if (refCheckWin(board, 'O')) return 1000 - depth;
+    if (refCheckWin(board, 'X')) return -1000 + depth;
+    if (depth == 0) return refEvaluateBoard(board);
+
+    int best = isMaximizing ? -10000 : 10000;
+    for (int col = 0; col < COLS; col++) {
+        char copy[ROWS][COLS];
+        memcpy(copy, board, sizeof(copy));
+        if (!dropPiece(copy, col, isMaximizing ? 'O' : 'X')) continue;
+
+        int eval = refMinimax(copy, depth - 1, !isMaximizing);
+        if (isMaximizing ? eval > best : eval < best) best = eval;
+    }
+    return best;
+}
+
+/**
+ * Runs every differential check on the position reached by the move list.
+ * Returns the name of the first routine that disagrees with its reference, or NULL if all match.
+ */
+static const char *findMismatch(const int moves[], int count, int checkSearch) {
+    char board[ROWS][COLS], copy[ROWS][COLS];
+    int validMoves[COLS];
+
+    if (!replayMoves(board, moves, count)) return NULL;
+
+    if (checkWin(board, 'X') != refCheckWin(board, 'X')) return "checkWin('X')";
+    if (checkWin(board, 'O') != refCheckWin(board, 'O')) return "checkWin('O')";
+    if (evaluateBoard(board) != refEvaluateBoard(board)) return "evaluateBoard";
+
+    // Move generation: a column is listed if and only if a piece can be dropped into it,
+    // and undoing the drop restores the board exactly
+    int validCount = getValidMoves(board, validMoves);
+    int listed = 0;
+    for (int col = 0; col < COLS; col++) {
+        memcpy(copy, board, sizeof(copy));
+        int playable = dropPiece(copy, col, (count % 2 == 0) ? 'X' : 'O');
+        int inList = (listed < validCount && validMoves[listed] == col);
+        if (playable != inList) return "getValidMoves";
+        if (inList) listed++;
+        if (playable && (!undoPiece(copy, col) || memcmp(copy, board, sizeof(copy)) != 0)) return "undoPiece";
+    }
+    if (listed != validCount) return "getValidMoves";
+
+    if (checkSearch) {
+        for (int isMaximizing = 0; isMaximizing <= 1; isMaximizing++) {
+            memcpy(copy, board, sizeof(copy));
+            int score = minimax(copy, SEARCH_CHECK_DEPTH, -10000, 10000, isMaximizing);
+            if (memcmp(copy, board, sizeof(copy)) != 0) return "minimax (board not restored)";
+            if (score != refMinimax(board, SEARCH_CHECK_DEPTH, isMaximizing)) return "minimax";
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Shrinks a failing move list: repeatedly drops single moves (and then trailing moves)
+ * as long as the list stays a legal game that still fails. Returns the new length.
+ */
+static int shrinkMoves(int moves[], int count, int checkSearch) {
+    int trial[MAX_MOVES];
+    int shrunk = 1;
+
+    while (shrunk) {
+        shrunk = 0;
+        for (int skip = 0; skip < count; skip++) {
+            int n = 0;
+            for (int i = 0; i < count; i++) {
+                if (i != skip) trial[n++] = moves[i];
+            }
+            if (findMismatch(trial, n, checkSearch)) {
+                memcpy(moves, trial, n * sizeof(int));
+                count = n;
+                shrunk = 1;
+                break;
+            }
+        }
+    }
+
+    return count;
+}
+
+/**
+ * Randomized differential test of the engine.
+ * Generates random legal games, stops each at a random ply, and compares checkWin, evaluateBoard,
+ * getValidMoves, undoPiece and (on every SEARCH_CHECK_INTERVAL-th position) minimax against the
+ * reference implementations above. On the first mismatch the move list is shrunk and printed
+ * together with the seed, so the failure can be replayed.
+ *
+ * @param seed The seed of the random generator (must not be 0).
+ * @param positions The number of random positions to check.
+ * @return 1 if every position matched, 0 otherwise.
+ */
+int testRandomized(unsigned long long seed, long positions) {
+    char board[ROWS][COLS];
+    int moves[MAX_MOVES];
+
+    rngState = seed;
+
+    for (long p = 0; p < positions; p++) {
+        int length = (int)(nextRandom() % (MAX_MOVES + 1));
+        char piece;
+        int count = playRandomGame(board, moves, length, &piece);
+
+        int checkSearch = (p % SEARCH_CHECK_INTERVAL == 0);
+        const char *failed = findMismatch(moves, count, checkSearch);
+        if (failed) {
+            count = shrinkMoves(moves, count, checkSearch);
+            failed = findMismatch(moves, count, checkSearch);
+
+            printf("randomized FAILED (%s differs from the reference, seed %llu, position %ld)\n", failed, seed, p);
+            printf("Shrunk move list (%d moves): ", count);
+            for (int i = 0; i < count; i++) printf("%d", moves[i] + 1);
+            printf("\n");
+            replayMoves(board, moves, count);
+            printBoard(board);
+            return 0;
+        }
+    }
+
+    printf("randomized PASSED (%ld positions, seed %llu)\n", positions, seed);
+    return 1;
+}
+
+/**
+ * Reference endgame solver: plain exhaustive search without any table.
+ * Returns TB_WIN, TB_DRAW or TB_LOSS for the player to move and the distance to the end of the game
+ * with the winner playing for the shortest and the loser for the longest game.
+ */
+static int refSolve(char board[ROWS][COLS], char piece, int *distance) {
+    char opponent = (piece == 'X') ? 'O' : 'X';
+    int bestResult = 0, bestDistance = 0, anyMove = 0;
+
+    for (int col = 0; col < COLS; col++) {
+        int result, childDistance = 0;
+        if (!dropPiece(board, col, piece)) continue;
+        anyMove = 1;
+
+        if (refCheckWin(board, piece)) {
+            result = TB_WIN;
+        } else {
+            int childResult = refSolve(board, opponent, &childDistance);
+            result = (childResult == TB_WIN) ? TB_LOSS : (childResult == TB_LOSS) ? TB_WIN : TB_DRAW;
+        }
+        undoPiece(board, col);
+        childDistance++;
+
+        if (result > bestResult ||
+            (result == bestResult && result == TB_WIN && childDistance < bestDistance) ||
+            (result == bestResult && result != TB_WIN && childDistance > bestDistance)) {
+            bestResult = result;
+            bestDistance = childDistance;
+        }
+    }
+
+    *distance = bestDistance;
+    return anyMove ? bestResult : TB_DRAW;
+}
+
+/**
+ * Tests the endgame tablebase end to end.
+ * Generates a small tablebase (up to 8 empty cells) into a temporary file and maps it with loadTablebase.
+ * Then replays the generator's random endgames, walks down from them with random moves and checks that
+ * every position is in the table, that every probe agrees with refSolve,
+ * that getTablebaseMove achieves the probed result, and that minimax, searching a position just outside
+ * the table, returns the score of its best child according to refSolve.
+ * Finally checks that a file with an unsorted block index or a header claiming too many positions is rejected.
+ * Prints "tablebase PASSED" if all checks match, "tablebase FAILED" with the first mismatch otherwise.
+ */
+int testTablebase(unsigned long long seed) {
+    char path[TEST_PATH_SIZE];
+    char board[ROWS][COLS];
+    int fd, pass = 1, probes = 0;
+
+    if (!createTestFile(path, "tablebase")) return 0;
+
+    srand((unsigned)seed);
+    if (!generateTablebase(path, 8, 2000, 20) || !loadTablebase(path)) {
+        printf("tablebase FAILED (Could not generate or load the tablebase)\n");
+        unlink(path);
+        return 0;
+    }
+
+    // Replay the generator's endgames and walk down from them with random moves
+    srand((unsigned)seed);
+    rngState = seed;
+    for (int game = 0; game < 2000 && pass; game++) {
+        char piece;
+        if (!playRandomEndgame(board, 8, &piece)) continue;
+
+        while (pass) {
+            int result, distance, refDistance, childResult = TB_DRAW, childDistance;
+
+            if (!probeTablebase(board, piece, &result, &distance)) {
+                printf("tablebase FAILED (Endgame position missing from the tablebase)\n");
+                pass = 0;
+                break;
+            }
+            probes++;
+
+            int refResult = refSolve(board, piece, &refDistance);
+            if (result != refResult || distance != refDistance) {
+                printf("tablebase FAILED (Probe %d/%d, reference %d/%d)\n", result, distance, refResult, refDistance);
+                pass = 0;
+                break;
+            }
+
+            if (countEmptyCells(board) == 0) break; // Drawn, nothing left to play
+
+            // Hide this position from the table so minimax has to search it and combine the
+            // probes of its children; the expected score is built from refSolve instead
+            int expected = (piece == 'O') ? -10000 : 10000;
+            for (int col = 0; col < COLS; col++) {
+                int childScore;
+                if (!dropPiece(board, col, piece)) continue;
+                if (refCheckWin(board, piece)) {
+                    childScore = (piece == 'O') ? 1000 - 2 : -1000 + 2;
+                } else {
+                    char opponent = (piece == 'X') ? 'O' : 'X';
+                    int childResult = refSolve(board, opponent, &childDistance);
+                    childScore = tablebaseScore(childResult, childDistance, 2, opponent);
+                }
+                undoPiece(board, col);
+                if (piece == 'O' ? childScore > expected : childScore < expected) expected = childScore;
+            }
+
+            int savedMaxEmpty = tbMaxEmpty;
+            tbMaxEmpty = countEmptyCells(board) - 1;
+            int score = minimax(board, 3, -10000, 10000, piece == 'O');
+            tbMaxEmpty = savedMaxEmpty;
+            if (score != expected) {
+                printf("tablebase FAILED (minimax returned %d, expected %d from the reference solver)\n", score, expected);
+                pass = 0;
+                break;
+            }
+
+            // The chosen move must keep the probed result
+            int col = getTablebaseMove(board, piece);
+            if (col < 0) {
+                printf("tablebase FAILED (No tablebase move for a covered position)\n");
+                pass = 0;
+                break;
+            }
+            dropPiece(board, col, piece);
+            int won = checkWin(board, piece);
+            if (!won) childResult = refSolve(board, piece == 'X' ? 'O' : 'X', &childDistance);
+            undoPiece(board, col);
+            int achieved = won ? TB_WIN : (childResult == TB_WIN) ? TB_LOSS : (childResult == TB_LOSS) ? TB_WIN : TB_DRAW;
+            if (achieved != result) {
+                printf("tablebase FAILED (getTablebaseMove played column %d, losing the result)\n", col);
+                pass = 0;
+                break;
+            }
+
+            // Continue with a random move until the game ends
+            playRandomMove(board, piece);
+            if (checkWin(board, piece)) break;
+            piece = (piece == 'X') ? 'O' : 'X';
+        }
+    }
+
+    closeTablebase();
+
+    // A block index that is out of order, or a header claiming more positions than its blocks hold,
+    // must be rejected
+    if (pass) {
+        TablebaseHeader header;
+        TablebaseBlock block;
+        fd = open(path, O_RDWR);
+        if (fd < 0 || pread(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header) || header.blockCount < 2 ||
+            pread(fd, &block, sizeof(block), sizeof(header) + sizeof(block)) != (ssize_t)sizeof(block)) {
+            printf("tablebase FAILED (Could not reopen the tablebase file)\n");
+            pass = 0;
+        } else {
+            TablebaseBlock corrupt = block;
+            corrupt.offset = 0;
+            if (pwrite(fd, &corrupt, sizeof(corrupt), sizeof(header) + sizeof(block)) != (ssize_t)sizeof(corrupt) ||
+                loadTablebase(path)) {
+                printf("tablebase FAILED (Tablebase with an unsorted block index was accepted)\n");
+                closeTablebase();
+                pass = 0;
+            }
+            header.count = (uint64_t)header.blockCount * TB_BLOCK_ENTRIES + 1;
+            if (pass && (pwrite(fd, &block, sizeof(block), sizeof(header) + sizeof(block)) != (ssize_t)sizeof(block) ||
+                         pwrite(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header) || loadTablebase(path))) {
+                printf("tablebase FAILED (Tablebase with an invalid count was accepted)\n");
+                closeTablebase();
+                pass = 0;
+            }
+        }
+        if (fd >= 0) close(fd);
+    }
+    unlink(path);
+
+    if (pass && probes == 0) {
+        printf("tablebase FAILED (No random position reached the tablebase)\n");
+        pass = 0;
+    }
+    if (pass) printf("tablebase PASSED (%d probes)\n", probes);
+    return pass;
+}
+
+/**
+ * Tests the mirror symmetry helpers and the symmetric pruning.
+ * For random positions, checks that getMirroredKey is its own inverse, that a board and its mirror share
+ * the same canonical key (with the mirrored flag set on exactly one side unless the board is symmetric),
+ * and that evaluateBoard and minimax give both the same score.
+ * Then checks that getAIChoice on the empty board matches an unpruned reference choice.
+ * Prints "symmetry PASSED" if all checks match, "symmetry FAILED" with the first mismatch otherwise.
+ */
+int testSymmetry(unsigned long long seed) {
+    char board[ROWS][COLS], mirror[ROWS][COLS];
+
+    rngState = seed;
+    for (int game = 0; game < 2000; game++) {
+        char piece;
+        playRandomGame(board, NULL, (int)(nextRandom() % 20), &piece);
+        mirrorBoard(board, mirror);
+
+        uint64_t key = getPositionKey(board, piece);
+        int mirroredBoard, mirroredMirror;
+        uint64_t canonical = getCanonicalKey(board, piece, &mirroredBoard);
+        uint64_t canonicalMirror = getCanonicalKey(mirror, piece, &mirroredMirror);
+
+        if (getMirroredKey(getMirroredKey(key)) != key || getMirroredKey(key) != getPositionKey(mirror, piece)) {
+            printf("symmetry FAILED (getMirroredKey does not mirror the key)\n");
+            return 0;
+        }
+        if (canonical != canonicalMirror || (mirroredBoard == mirroredMirror && !isSymmetric(board))) {
+            printf("symmetry FAILED (Canonical keys of a board and its mirror differ)\n");
+            return 0;
+        }
+        if (isSymmetric(board) != (memcmp(board, mirror, sizeof(board)) == 0)) {
+            printf("symmetry FAILED (isSymmetric returned %d)\n", isSymmetric(board));
+            return 0;
+        }
+        if (evaluateBoard(board) != evaluateBoard(mirror) ||
+            minimax(board, 3, -10000, 10000, piece == 'O') != minimax(mirror, 3, -10000, 10000, piece == 'O')) {
+            printf("symmetry FAILED (A board and its mirror score differently)\n");
+            return 0;
+        }
+    }
+
+    // getAIChoice only searches the left half of the empty board, the choice must not change
+    int savedDepth = depth;
+    int expected = -1, bestScore = -10000;
+    depth = 3;
+    initBoard(board);
+    for (int col = 0; col < COLS; col++) {
+        dropPiece(board, col, 'O');
+        int score = refMinimax(board, depth, 0);
+        undoPiece(board, col);
+        if (score > bestScore) {
+            bestScore = score;
+            expected = col;
+        }
+    }
+    int choice = getAIChoice(board, -1);
+    depth = savedDepth;
+
+    if (choice != expected) {
+        printf("symmetry FAILED (getAIChoice on the empty board: expected %d, got %d)\n", expected, choice);
+        return 0;
+    }
+
+    printf("symmetry PASSED\n");
+    return 1;
+}
+
+/**
+ * Writes a network file for the tests. Returns 1 on success.
+ */
+static int writeTestNetwork(const char *path, int16_t bias[NNUE_HIDDEN], int16_t weights[NNUE_FEATURES][NNUE_HIDDEN],
+                            int8_t outputWeights[NNUE_HIDDEN], int32_t outputBias, int32_t outputShift) {
+    NetworkHeader header;
+    memcpy(header.magic, NNUE_MAGIC, 4);
+    header.version = NNUE_VERSION;
+    header.rows = ROWS;
+    header.cols = COLS;
+    header.hidden = NNUE_HIDDEN;
+    header.outputShift = outputShift;
+
+    FILE *file = fopen(path, "wb");
+    if (!file) return 0;
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+             fwrite(bias, sizeof(int16_t) * NNUE_HIDDEN, 1, file) == 1 &&
+             fwrite(weights, sizeof(int16_t) * NNUE_FEATURES * NNUE_HIDDEN, 1, file) == 1 &&
+             fwrite(outputWeights, sizeof(int8_t) * NNUE_HIDDEN, 1, file) == 1 &&
+             fwrite(&outputBias, sizeof(outputBias), 1, file) == 1;
+    return fclose(file) == 0 && ok;
+}
+
+/**
+ * Tests the neural network evaluator.
+ * Writes a network with random mirror-symmetric weights to a temporary file and loads it.
+ * Plays random games, dropping and taking back pieces, and checks after every step that the incrementally
+ * updated evaluateNetwork (AVX2 when compiled with -mavx2) matches a plain scalar evaluation from scratch.
+ * Also checks that minimax leaves the accumulator untouched, that mirrored boards score the same,
+ * that a network with asymmetric weights or an output bias that could overflow the sum is rejected,
+ * and that a rejected network leaves the evaluation version of the search cache unchanged.
+ * Prints "network PASSED" if all checks match, "network FAILED" with the first mismatch otherwise.
+ */
+int testNetwork(unsigned long long seed) {
+    static int16_t weights[NNUE_FEATURES][NNUE_HIDDEN];
+    int16_t bias[NNUE_HIDDEN], saved[NNUE_HIDDEN];
+    int8_t outputWeights[NNUE_HIDDEN];
+    int32_t outputBias, outputShift = 4;
+    char path[TEST_PATH_SIZE];
+    char board[ROWS][COLS], mirror[ROWS][COLS];
+    int pass = 1;
+
+    if (!createTestFile(path, "network")) return 0;
+
+    uint64_t evalVersion = getEvalVersion(); // Without a network
+
+    rngState = seed;
+    for (int i = 0; i < NNUE_HIDDEN; i++) {
+        bias[i] = (int16_t)((int)(nextRandom() % 1001) - 500);
+        outputWeights[i] = (int8_t)((int)(nextRandom() % 255) - 127);
+        for (int row = 0; row < ROWS; row++) {
+            for (int col = 0; col <= COLS / 2; col++) {
+                for (int p = 0; p < 2; p++) {
+                    int16_t w = (int16_t)((int)(nextRandom() % 401) - 200);
+                    weights[p * ROWS * COLS + row * COLS + col][i] = w;
+                    weights[p * ROWS * COLS + row * COLS + (COLS - 1 - col)][i] = w;
+                }
+            }
+        }
+    }
+    outputBias = (int32_t)(nextRandom() % 2001) - 1000;
+
+    if (!writeTestNetwork(path, bias, weights, outputWeights, outputBias, outputShift) || !loadNetwork(path)) {
+        printf("network FAILED (Could not write or load the network)\n");
+        unlink(path);
+        return 0;
+    }
+
+    for (int game = 0; game < 500 && pass; game++) {
+        char piece = 'X';
+        initBoard(board);
+        refreshNetwork(board);
+
+        while (pass) {
+            // Reference: plain scalar forward pass from scratch
+            int32_t sum = 0;
+            for (int i = 0; i < NNUE_HIDDEN; i++) {
+                int32_t acc = bias[i];
+                for (int row = 0; row < ROWS; row++)
+                    for (int col = 0; col < COLS; col++)
+                        if (board[row][col] != ' ')
+                            acc += weights[(board[row][col] == 'O' ? 0 : ROWS * COLS) + row * COLS + col][i];
+                sum += (acc < 0 ? 0 : acc > 127 ? 127 : acc) * outputWeights[i];
+            }
+            int expected = (sum + outputBias) >> outputShift;
+            if (expected > NNUE_SCORE_LIMIT) expected = NNUE_SCORE_LIMIT;
+            if (expected < -NNUE_SCORE_LIMIT) expected = -NNUE_SCORE_LIMIT;
+
+            if (evaluateNetwork() != expected) {
+                printf("network FAILED (Incremental evaluation %d, expected %d)\n", evaluateNetwork(), expected);
+                pass = 0;
+                break;
+            }
+
+            if (nextRandom() % 8 == 0) {
+                // Search must restore the accumulator, and a mirrored board must score the same
+                memcpy(saved, networkAccumulator, sizeof(saved));
+                int score = minimax(board, 2, -10000, 10000, piece == 'O');
+                if (memcmp(saved, networkAccumulator, sizeof(saved)) != 0) {
+                    printf("network FAILED (minimax did not restore the accumulator)\n");
+                    pass = 0;
+                    break;
+                }
+                mirrorBoard(board, mirror);
+                refreshNetwork(mirror);
+                int mirrorScore = minimax(mirror, 2, -10000, 10000, piece == 'O');
+                refreshNetwork(board);
+                if (score != mirrorScore) {
+                    printf("network FAILED (Mirrored boards score %d and %d)\n", score, mirrorScore);
+                    pass = 0;
+                    break;
+                }
+            }
+
+            int col = playRandomMove(board, piece);
+            if (col < 0) break;
+            int row = 0;
+            while (board[row][col] == ' ') row++;
+            addNetworkPiece(row, col, piece);
+
+            // Sometimes take the move back again
+            if (nextRandom() % 4 == 0) {
+                removeNetworkPiece(row, col, piece);
+                undoPiece(board, col);
+                continue;
+            }
+            if (checkWin(board, piece)) break;
+            piece = (piece == 'X') ? 'O' : 'X';
+        }
+    }
+
+    // An output bias that could overflow the int32 sum must be rejected (this also disables the network again)
+    if (pass && (!writeTestNetwork(path, bias, weights, outputWeights, INT32_MAX - 1000, outputShift) || loadNetwork(path))) {
+        printf("network FAILED (Overflowing output bias was accepted)\n");
+        pass = 0;
+    }
+
+    // A network that is not mirror-symmetric must be rejected
+    weights[0][0] = (int16_t)(weights[COLS - 1][0] + 1);
+    if (pass && (!writeTestNetwork(path, bias, weights, outputWeights, outputBias, outputShift) || loadNetwork(path))) {
+        printf("network FAILED (Asymmetric network was accepted)\n");
+        pass = 0;
+    }
+    if (pass && getEvalVersion() != evalVersion) {
+        printf("network FAILED (Rejected network changed the evaluation version)\n");
+        pass = 0;
+    }
+    networkLoaded = 0;
+    unlink(path);
+
+    if (pass) printf("network PASSED\n");
+    return pass;
+}
+
+/**
+ * Tests the persistent search cache.
+ * Creates a cache in a temporary file, stores getAIChoice results for random positions and checks that they
+ * are found again (mirrored boards get the mirrored move), also after closing and reopening the file.
+ * Then checks that a corrupted entry is ignored, that a tiny cache keeps the latest result while evicting
+ * older ones (also entries from more than 256 runs ago), and that a cache with another evaluation version is discarded.
+ * Prints "searchCache PASSED" if all checks match, "searchCache FAILED" with the first mismatch otherwise.
+ */
+int testSearchCache(unsigned long long seed) {
+    char path[TEST_PATH_SIZE];
+    char boards[50][ROWS][COLS], mirror[ROWS][COLS];
+    int choices[50], moves[MAX_MOVES];
+    int savedDepth = depth, pass = 1;
+    int fd, score, move;
+
+    if (!createTestFile(path, "searchCache")) return 0;
+
+    depth = 2;
+    rngState = seed;
+    if (openSearchCache(path, 8) != 2) {
+        printf("searchCache FAILED (Could not create the cache)\n");
+        pass = 0;
+    }
+
+    // Random non-final positions with 'O' to move, searched once to fill the cache
+    for (int p = 0; p < 50 && pass; p++) {
+        char piece;
+        int count = playRandomGame(boards[p], moves, 2 * (int)(nextRandom() % 10), &piece);
+        if (count > 0 && checkWin(boards[p], piece == 'X' ? 'O' : 'X')) {
+            undoPiece(boards[p], moves[count - 1]); // Take back the winning move
+            piece = (piece == 'X') ? 'O' : 'X';
+        }
+        if (piece != 'O') dropPiece(boards[p], COLS / 2, 'X');
+        if (checkWin(boards[p], 'X') || countEmptyCells(boards[p]) == 0) {
+            initBoard(boards[p]);
+            dropPiece(boards[p], 0, 'X');
+        }
+        choices[p] = getAIChoice(boards[p], -1);
+    }
+
+    for (int reopened = 0; reopened <= 1 && pass; reopened++) {
+        if (reopened && openSearchCache(path, 8) != 1) {
+            printf("searchCache FAILED (Existing cache was not reused)\n");
+            pass = 0;
+            break;
+        }
+        for (int p = 0; p < 50; p++) {
+            mirrorBoard(boards[p], mirror);
+
+            if (!probeSearchCache(boards[p], 'O', depth, &score, &move) || move != choices[p]) {
+                printf("searchCache FAILED (Stored result not found%s)\n", reopened ? " after reopening" : "");
+                pass = 0;
+                break;
+            }
+            int mirrorMove = isSymmetric(boards[p]) ? choices[p] : COLS - 1 - choices[p]; // A symmetric board is its own mirror
+            if (!probeSearchCache(mirror, 'O', depth, &score, &move) || move != mirrorMove) {
+                printf("searchCache FAILED (Mirrored board did not get the mirrored move)\n");
+                pass = 0;
+                break;
+            }
+            if (probeSearchCache(boards[p], 'O', depth + 1, &score, &move)) {
+                printf("searchCache FAILED (Result found for another depth)\n");
+                pass = 0;
+                break;
+            }
+        }
+    }
+
+    // An entry checked under another evaluation version must not validate
+    if (pass) {
+        searchCacheEvalVersion ^= 1;
+        if (probeSearchCache(boards[0], 'O', depth, &score, &move)) {
+            printf("searchCache FAILED (Entry from another evaluation version was accepted)\n");
+            pass = 0;
+        }
+        searchCacheEvalVersion ^= 1;
+    }
+
+    // An entry whose move is off the board must be rejected even with a valid checksum, and
+    // getAIChoice must search again when the cached column is full
+    if (pass) {
+        int mirrored;
+        uint64_t key = getCanonicalKey(boards[0], 'O', &mirrored);
+        SearchCacheEntry *bucket = searchCacheBucket(key, depth);
+        for (int w = 0; w < SEARCH_CACHE_WAYS; w++) {
+            uint64_t data = atomic_load(&bucket[w].data);
+            if ((atomic_load(&bucket[w].check) ^ data) == key) {
+                uint64_t payload = SC_PAYLOAD(SC_SCORE(data), depth, COLS + 1, SC_GENERATION(data));
+                data = payload | (searchCacheChecksum(key, payload) << 48);
+                atomic_store(&bucket[w].data, data);
+                atomic_store(&bucket[w].check, key ^ data);
+            }
+        }
+        if (probeSearchCache(boards[0], 'O', depth, &score, &move)) {
+            printf("searchCache FAILED (Entry with an invalid move was accepted)\n");
+            pass = 0;
+        }
+
+        char full[ROWS][COLS];
+        initBoard(full);
+        for (int row = 0; row < ROWS; row++) dropPiece(full, 0, row % 2 ? 'O' : 'X');
+        for (int row = 0; row < 3; row++) dropPiece(full, 1, row % 2 ? 'O' : 'X');
+        storeSearchCache(full, 'O', depth, 0, 0);
+        if (pass && getAIChoice(full, -1) == 0) {
+            printf("searchCache FAILED (Cached move into a full column was played)\n");
+            pass = 0;
+        }
+        storeSearchCache(boards[0], 'O', depth, 0, choices[0]); // Restore a valid entry for the next check
+    }
+
+    // Flip a payload bit of a stored entry in both words: the key check still passes, the checksum must reject it
+    if (pass) {
+        int mirrored;
+        uint64_t key = getCanonicalKey(boards[0], 'O', &mirrored);
+        SearchCacheEntry *bucket = searchCacheBucket(key, depth);
+        for (int w = 0; w < SEARCH_CACHE_WAYS; w++) {
+            if ((atomic_load(&bucket[w].check) ^ atomic_load(&bucket[w].data)) == key) {
+                atomic_fetch_xor(&bucket[w].data, (uint64_t)1 << 24);
+                atomic_fetch_xor(&bucket[w].check, (uint64_t)1 << 24);
+            }
+        }
+        if (probeSearchCache(boards[0], 'O', depth, &score, &move)) {
+            printf("searchCache FAILED (Corrupted entry was accepted)\n");
+            pass = 0;
+        }
+    }
+
+    // A cache of 2 buckets holds 8 entries: the latest store always survives.
+    // Replacing the file must leave a mapping of the old one (as held by another process) readable.
+    size_t oldSize = searchCacheSize;
+    void *oldMapping = MAP_FAILED;
+    if (pass && (fd = open(path, O_RDONLY)) >= 0) {
+        oldMapping = mmap(NULL, oldSize, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+    }
+    if (pass && (oldMapping == MAP_FAILED || openSearchCache(path, 1) != 2)) {
+        printf("searchCache FAILED (Resized cache was not recreated)\n");
+        pass = 0;
+    }
+    if (oldMapping != MAP_FAILED) {
+        if (pass && memcmp(oldMapping, SEARCH_CACHE_MAGIC, 4) != 0) {
+            printf("searchCache FAILED (Old mapping changed when the cache was replaced)\n");
+            pass = 0;
+        }
+        volatile char last = ((volatile char *)oldMapping)[oldSize - 1]; // Faults if the old file was truncated
+        (void)last;
+        munmap(oldMapping, oldSize);
+    }
+    for (int p = 0; p < 50 && pass; p++) {
+        storeSearchCache(boards[p], 'O', depth, p, choices[p]);
+        if (!probeSearchCache(boards[p], 'O', depth, &score, &move) || score != p || move != choices[p]) {
+            printf("searchCache FAILED (Latest result was evicted)\n");
+            pass = 0;
+        }
+    }
+    if (pass) {
+        int found = 0;
+        for (int p = 0; p < 50; p++) {
+            int duplicate = 0; // Random positions can repeat (or mirror) each other
+            for (int q = 0; q < p; q++)
+                duplicate |= getCanonicalKey(boards[q], 'O', NULL) == getCanonicalKey(boards[p], 'O', NULL);
+            if (!duplicate) found += probeSearchCache(boards[p], 'O', depth, &score, &move);
+        }
+        if (found > 2 * SEARCH_CACHE_WAYS) {
+            printf("searchCache FAILED (%d entries found in a cache of %d)\n", found, 2 * SEARCH_CACHE_WAYS);
+            pass = 0;
+        }
+    }
+
+    // An entry written 256 runs ago is still the oldest of its bucket and evicted first
+    if (pass) {
+        uint64_t key = getCanonicalKey(boards[0], 'O', NULL);
+        SearchCacheEntry *bucket = searchCacheBucket(key, depth);
+        for (int w = 0; w < SEARCH_CACHE_WAYS; w++) {
+            int age = (w == 0) ? 256 : 1;
+            uint64_t other = key ^ (uint64_t)(w + 1); // Positions that share the bucket
+            uint64_t payload = SC_PAYLOAD(0, depth, 0, (searchCacheGeneration - age) & SC_GENERATION_MASK);
+            uint64_t data = payload | (searchCacheChecksum(other, payload) << 48);
+            atomic_store(&bucket[w].data, data);
+            atomic_store(&bucket[w].check, other ^ data);
+        }
+        storeSearchCache(boards[0], 'O', depth, 0, choices[0]);
+        if ((atomic_load(&bucket[0].check) ^ atomic_load(&bucket[0].data)) != key) {
+            printf("searchCache FAILED (Entry from 256 runs ago was not evicted first)\n");
+            pass = 0;
+        }
+    }
+
+    // Another evaluation version must discard the cache
+    if (pass) {
+        searchCache->evalVersion ^= 1;
+        closeSearchCache();
+        if (openSearchCache(path, 1) != 2 || probeSearchCache(boards[49], 'O', depth, &score, &move)) {
+            printf("searchCache FAILED (Cache from another evaluation version was reused)\n");
+            pass = 0;
+        }
+    }
+
+    closeSearchCache();
+    unlink(path);
+    depth = savedDepth;
+
+    if (pass) printf("searchCache PASSED\n");
+    return pass;
+}
+
+/**
+ * Entry point of the test binary: ./ConnectFourTest [positions] [seed]
+ * Runs the unit tests and the randomized differential tests, and exits with 1 if any of them failed.
+ */
+int main(int argc, char *argv[]) {
+    long positions = (argc > 1) ? atol(argv[1]) : 1000000;
+    unsigned long long seed = (argc > 2) ? strtoull(argv[2], NULL, 10) : (unsigned long long)time(NULL);
+    int pass = 1;
+
+    if (seed == 0) seed = 1; // xorshift must not start from 0
+
+    pass &= testinitBoard();
+    pass &= testDropPiece();
+    pass &= testCheckWin();
+    pass &= testGetAlignmentLength();
+    pass &= testGetBestMove();
+    pass &= testGetAIChoice();
+    pass &= testPerft();
+    pass &= testRandomized(seed, positions);
+    pass &= testTablebase(seed);
+    pass &= testSymmetry(seed);
+    pass &= testNetwork(seed);
+    pass &= testSearchCache(seed);
+
+    printf(pass ? "\nAll tests PASSED\n" : "\nSome tests FAILED\n");
+    return pass ? 0 : 1;
 }
+#endif